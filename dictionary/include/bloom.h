@@ -0,0 +1,96 @@
+/**
+ * @file    bloom.h
+ * @brief   Defining and implementing a Bloom filter for the dictionaries.
+ */
+
+#ifndef _BLOOM_H_
+#define _BLOOM_H_
+
+#include <cstdint>    // std::uint64_t
+#include <functional> // std::hash
+#include <vector>
+
+namespace ac
+{
+	/**
+	 * @brief      Blocked Bloom filter: every key sets and tests bits of a
+	 *             single 64 byte block, so a test costs one cache miss. May
+	 *             answer that a key is present when it is not, never the
+	 *             opposite.
+	 *
+	 * @tparam     Key      Key of the element.
+	 * @tparam     KeyHash  Functor to hash the key.
+	 */
+	template< typename Key, typename KeyHash = std::hash<Key> >
+	class Bloom
+	{
+		public:
+
+			/**
+			 * @brief      Creates an empty filter for a number of keys.
+			 *
+			 * @param[in]  _n            How many keys will be added.
+			 * @param[in]  _BitsPerKey   Bits of the filter per key. Provided
+			 *                           none, default value is 10 (about 1%
+			 *                           of false positives).
+			 */
+			explicit Bloom ( int _n = 0, int _BitsPerKey = 10 )
+				: mi_Blocks( ( static_cast< std::uint64_t >( _n < 1 ? 1 : _n ) * _BitsPerKey + BLOCK_BITS - 1 ) / BLOCK_BITS )
+				, mi_Hashes( _BitsPerKey * 69 / 100 < 1 ? 1 : _BitsPerKey * 69 / 100 )
+				, mv_Bits( mi_Blocks * WORDS, 0 )
+			{ /* empty */ }
+
+			/**
+			 * @brief      Adds a key to the filter.
+			 */
+			void add ( const Key & _x )
+			{
+				auto h = _mix( KeyHash()( _x ) );
+				auto block = &mv_Bits[ ( h % mi_Blocks ) * WORDS ];
+				auto step = ( h >> 32 ) | 1;
+				for ( auto i(0); i < mi_Hashes; ++i, h += step )
+					block[ ( h >> 6 ) % WORDS ] |= std::uint64_t(1) << ( h & 63 );
+			}
+
+			/**
+			 * @brief      Tests if a key may have been added.
+			 *
+			 * @return     False if the key was surely not added. True
+			 *             otherwise.
+			 */
+			bool may_contain ( const Key & _x ) const
+			{
+				auto h = _mix( KeyHash()( _x ) );
+				auto block = &mv_Bits[ ( h % mi_Blocks ) * WORDS ];
+				auto step = ( h >> 32 ) | 1;
+				for ( auto i(0); i < mi_Hashes; ++i, h += step )
+					if ( not ( block[ ( h >> 6 ) % WORDS ] & ( std::uint64_t(1) << ( h & 63 ) ) ) ) return false;
+				return true;
+			}
+
+		private:
+
+			static const int WORDS = 8;              // 64 bit words per block (a cache line)
+			static const int BLOCK_BITS = 64 * WORDS;
+
+			/**
+			 * @brief      Spreads the bits of a hash (std::hash of integers is
+			 *             often the identity).
+			 */
+			static std::uint64_t _mix ( std::uint64_t _h )
+			{
+				_h ^= _h >> 33;
+				_h *= 0xff51afd7ed558ccdull;
+				_h ^= _h >> 33;
+				_h *= 0xc4ceb9fe1a85ec53ull;
+				_h ^= _h >> 33;
+				return _h;
+			}
+
+			std::uint64_t mi_Blocks;             // Number of blocks
+			int mi_Hashes;                       // Bits set per key
+			std::vector< std::uint64_t > mv_Bits;
+	};
+}
+
+#endif
@@ -9,6 +9,14 @@
 #ifndef _DAL_H_
 #define _DAL_H_
 
+#include <algorithm> // std::move, std::max
+#include <functional> // std::less
+#include <stdexcept> // std::out_of_range
+#include <iostream>
+#include <type_traits> // std::integral_constant, std::is_same, std::is_integral
+
+#include "layout.h"
+
 namespace ac
 {
 	/**
@@ -17,25 +25,73 @@ namespace ac
 	 * @tparam     Key            Key of the element.
 	 * @tparam     Data           Value associated to the key.
 	 * @tparam     KeyComparator  Functor to compare keys.
+	 * @tparam     Layout         AoS (default) to store each key with its data,
+	 *                            or SoA to store keys and data in parallel
+	 *                            arrays.
 	 */
-	template< typename Key, typename Data, typename KeyComparator = std::less<Key> >
+	template< typename Key, typename Data, typename KeyComparator = std::less<Key>, typename Layout = AoS >
 	class DAL
 	{
 		protected:
 			
+			static const int SIZE=50; // Defaul list size
+			static constexpr double GROWTH=2.0; // Default growth factor
+			int mi_Length;			  // Current lenght of the list
+			int mi_Capacity;		  // Current storage capacity
+			double md_Growth;		  // Factor by which the capacity grows when full
+			int mi_MinPos;			  // Position of the minimum key, -1 if empty
+			int mi_MaxPos;			  // Position of the maximum key, -1 if empty
+			Store< Key, Data, Layout > ms_Data; // Storage area, in the chosen layout
+
 			/**
-			 * @brief      Node structure representing pair key-information
+			 * @brief      Auxiliar function that makes room for more elements.
+			 *             If the dictionary is full, its capacity is
+			 *             multiplied by the growth factor (or more, if still
+			 *             not enough).
+			 *
+			 * @param[in]  _n    How many elements must fit. Provided none,
+			 *                   default value is 1.
+			 *
+			 * @return     True if there is room for the new elements. False
+			 *             if they do not fit and the dictionary has a fixed
+			 *             capacity (growth factor not greater than 1.0).
 			 */
-			struct NodeAL 
+			bool _ensure_room ( int _n = 1 )
 			{
-				Key id; // The key is a simple integer
-				Data info; // The information is a chain of chars
-			};
+				if ( mi_Length + _n <= mi_Capacity ) return true;
+				if ( md_Growth <= 1.0 ) return false;
+				auto new_capacity = static_cast< int >( mi_Capacity * md_Growth );
+				reserve( std::max( new_capacity, mi_Length + _n ) );
+				return true;
+			}
 
-			static const int SIZE=50; // Defaul list size
-			int mi_Length;			  // Current lenght of the list
-			int mi_Capacity;		  // Maximum storage capacity
-			NodeAL *mpt_Data;			  // Storage area: dinamic allocated array
+			/**
+			 * @brief      Auxiliar function that moves the stored elements to
+			 *             a new storage area with the given capacity.
+			 *
+			 * @param[in]  _NewCap  Capacity of the new storage area. Must not
+			 *                      be less than the current length.
+			 */
+			void _reallocate ( int _NewCap )
+			{
+				ms_Data.reallocate( mi_Length, _NewCap );
+				mi_Capacity = _NewCap;
+			}
+
+			/**
+			 * @brief      Auxiliar function that finds again the positions of
+			 *             the minimum and maximum keys with a linear scan.
+			 */
+			void _find_bounds ( void )
+			{
+				KeyComparator comp;
+				mi_MinPos = mi_MaxPos = ( mi_Length == 0 ? -1 : 0 );
+				for( auto i(1); i < mi_Length; ++i )
+				{
+					if ( comp( ms_Data.key(i), ms_Data.key(mi_MinPos) ) ) mi_MinPos = i;
+					if ( comp( ms_Data.key(mi_MaxPos), ms_Data.key(i) ) ) mi_MaxPos = i;
+				}
+			}
 
 			/**
 			 * @brief      Auxiliar search. Receives a key and return its
@@ -48,35 +104,123 @@ namespace ac
 			 *             error.
 			 */
 			int _search ( const Key & _x ) const
+			{
+				// Integer keys on their own array, compared by std::less, can be compared for equality with SIMD
+				return _search( _x, std::integral_constant< bool,
+					std::is_same< Layout, SoA >::value and std::is_integral< Key >::value
+					and ( sizeof( Key ) == 1 or sizeof( Key ) == 2 or sizeof( Key ) == 4 or sizeof( Key ) == 8 )
+					and std::is_same< KeyComparator, std::less< Key > >::value >() );
+			}
+
+			int _search ( const Key & _x, std::false_type ) const
 			{
 				KeyComparator comp;
 
 				for(auto i(0); i < mi_Length; ++i)
 				{
-					if( not comp( mpt_Data[i].id, _x ) and not comp( _x, mpt_Data[i].id )  )
+					if( not comp( ms_Data.key(i), _x ) and not comp( _x, ms_Data.key(i) )  )
 						return i;
 				}
 				return -1; 
 			}
 
+			int _search ( const Key & _x, std::true_type ) const
+			{
+				return simd_find( ms_Data.keys(), mi_Length, _x );
+			}
+
+			/**
+			 * @brief      Auxiliar function that stores a new element at the
+			 *             end of the array, growing it if needed, and keeps
+			 *             the positions of the minimum and maximum keys.
+			 *
+			 * @return     False if the dictionary is full and its capacity is
+			 *             fixed. True otherwise.
+			 */
+			bool _append ( const Key & _newKey, const Data & _newInfo )
+			{
+				// Checks if the dictionary can store new data
+				if ( not _ensure_room() ) return false;
+
+				ms_Data.key(mi_Length) = _newKey;
+				ms_Data.info(mi_Length) = _newInfo;
+				KeyComparator comp;
+				if ( mi_Length == 0 ) mi_MinPos = mi_MaxPos = 0;
+				else if ( comp( _newKey, ms_Data.key(mi_MinPos) ) ) mi_MinPos = mi_Length;
+				else if ( comp( ms_Data.key(mi_MaxPos), _newKey ) ) mi_MaxPos = mi_Length;
+				mi_Length++;
+				return true;
+			}
+
+			/**
+			 * @brief      Auxiliar function that removes the element at a
+			 *             position, filling the gap with the last element.
+			 *             Removing the minimum or maximum key costs one more
+			 *             scan to find the new one.
+			 *
+			 * @param[in]  _pos  Position of the element.
+			 * @param      _s    Where its data is stored.
+			 */
+			void _remove_at ( int _pos, Data & _s )
+			{
+				bool bound = ( _pos == mi_MinPos or _pos == mi_MaxPos );
+				_s = ms_Data.info(_pos);
+
+				// If the element is not at the end of the dictionary, the last one fills the gap
+				if ( _pos != mi_Length - 1 )
+				{
+					ms_Data.move( _pos, mi_Length - 1 );
+					if ( mi_MinPos == mi_Length - 1 ) mi_MinPos = _pos;
+					if ( mi_MaxPos == mi_Length - 1 ) mi_MaxPos = _pos;
+				}
+
+				mi_Length--;
+				if ( bound ) _find_bounds();
+			}
+
 			public:
 				
 				/**
 				 * @brief      Default constructor. Initializes dictionary,
 				 *
-				 * @param[in]  _MaxSz  Size of the dictionary. Provided none,
-				 *                     default value is 50.
+				 * @param[in]  _MaxSz   Initial size of the dictionary. Provided
+				 *                      none, default value is 50.
+				 * @param[in]  _Growth  Factor by which the capacity grows when
+				 *                      the dictionary is full. Provided none,
+				 *                      default value is 2.0. A factor not
+				 *                      greater than 1.0 keeps the capacity
+				 *                      fixed, and insertions fail once full.
 				 */
-				DAL ( int _MaxSz = SIZE )
+				DAL ( int _MaxSz = SIZE, double _Growth = GROWTH )
 					: mi_Length(0)
 					, mi_Capacity(_MaxSz)
-					, mpt_Data( new NodeAL[_MaxSz] )
+					, md_Growth(_Growth)
+					, mi_MinPos(-1)
+					, mi_MaxPos(-1)
+					, ms_Data( _MaxSz )
 					{ /* empty */ }
+
+				/**
+				 * @brief      Copy constructor. The copy has the same capacity
+				 *             and growth factor.
+				 *
+				 * @param[in]  _other  The dictionary to be copied.
+				 */
+				DAL ( const DAL & _other )
+					: mi_Length( _other.mi_Length )
+					, mi_Capacity( _other.mi_Capacity )
+					, md_Growth( _other.md_Growth )
+					, mi_MinPos( _other.mi_MinPos )
+					, mi_MaxPos( _other.mi_MaxPos )
+					, ms_Data( _other.ms_Data, _other.mi_Length, _other.mi_Capacity )
+					{ /* empty */ }
+
+				DAL & operator= ( const DAL & ) = delete;
 				
 				/**
 				 * @brief      Destroys the object.
 				 */
-				virtual ~DAL () { delete [] mpt_Data; }
+				virtual ~DAL () { /* empty */ }
 
 				/**
 				 * @brief      Retrieves the dictionary's maximum size.
@@ -88,6 +232,39 @@ namespace ac
 					return mi_Capacity;
 				}
 
+				/**
+				 * @brief      Retrieves how many elements are stored in the
+				 *             dictionary.
+				 *
+				 * @return     Number of elements.
+				 */
+				int size( void ) const
+				{
+					return mi_Length;
+				}
+
+				/**
+				 * @brief      Makes sure the dictionary can store at least
+				 *             _NewCap elements without growing again.
+				 *
+				 * @param[in]  _NewCap  The capacity requested.
+				 */
+				void reserve( int _NewCap )
+				{
+					if ( _NewCap <= mi_Capacity ) return;
+					_reallocate( _NewCap );
+				}
+
+				/**
+				 * @brief      Reduces the capacity of the dictionary to the
+				 *             number of elements stored.
+				 */
+				void shrink_to_fit( void )
+				{
+					if ( mi_Length == mi_Capacity ) return;
+					_reallocate( mi_Length );
+				}
+
 				/**
 				 * @brief      Checks if the dictionary is empty or not.
 				 *
@@ -104,6 +281,8 @@ namespace ac
 				 *             occurrence inside the dictionary and if found,
 				 *             removes it. Then, it takes the last element and
 				 *             inserts in the gap left by the removed element.
+				 *             Removing the minimum or maximum key costs one more
+				 *             scan to find the new one.
 				 *
 				 * @param[in]  _x    Key provided by the client to remove element.
 				 * @param      _s    Where the value of the element to be deleted
@@ -116,17 +295,7 @@ namespace ac
 					if ( empty() ) return false;
 					auto found_position = _search(_x);
 					if ( found_position == -1 ) return false;
-					
-					// If the found element is at the end of the dictionary, don't need to fill gap
-					if ( found_position == (mi_Length - 1) )						 
-						_s = mpt_Data[found_position].info;
-					else // Otherwise, we need to fill the gap with the last element of the dictionary
-					{
-						_s = mpt_Data[found_position].info;
-						mpt_Data[found_position] = mpt_Data[mi_Length - 1];
-					}			
-					
-					mi_Length--;
+					_remove_at( found_position, _s );
 					return true;
 				}
 
@@ -145,7 +314,7 @@ namespace ac
 					if ( empty() ) return false;
 					auto found_position = _search(_x);
 					if ( found_position == -1 ) return false;
-					_s = mpt_Data[found_position].info;
+					_s = ms_Data.info(found_position);
 					return true;
 				}
 
@@ -159,42 +328,27 @@ namespace ac
 				 */
 				bool insert ( const Key & _newKey, const Data & _newInfo )
 				{
-					// Checks if the dictionary can store new data
-					if ( mi_Length == mi_Capacity ) return false;
-
 					// Iterates over the array checking if the client's input is unique
-					for (auto i(0); i < mi_Length; ++i)
-						if ( mpt_Data[i].id == _newKey ) return false;
-
-					// Reaching here, the input is valid to be inserted
-					mpt_Data[mi_Length].id = _newKey;
-					mpt_Data[mi_Length].info = _newInfo;
-					mi_Length++;
+					if ( _search( _newKey ) != -1 ) return false;
 
-					return true;
+					return _append( _newKey, _newInfo );
 				}
 
 				/**
-				 * @brief      This function iterates over each element on the
-				 *             dictionary and searches for the minimum key.
+				 * @brief      Retrieves the minimum key, whose position is kept
+				 *             up to date by insert() and remove().
 				 *
 				 * @return     The minimum key.
 				 */				
 				Key min () const
 				{
 					if ( mi_Length == 0 ) throw std::out_of_range("Cannot find min key on an empty dictionary.");
-					KeyComparator comp;
-					auto curr_min = mpt_Data[0].id;
-					for( auto i(0); i != mi_Length; ++i )
-					{
-						if( comp( mpt_Data[i].id, curr_min ) ) curr_min = mpt_Data[i].id;
-					}
-					return curr_min;
+					return ms_Data.key(mi_MinPos);
 				}
 
 				/**
-				 * @brief      This function iterates over each element on the
-				 *             dictionary and searches for the maximum key.
+				 * @brief      Retrieves the maximum key, whose position is kept
+				 *             up to date by insert() and remove().
 				 *
 				 * @return     The maximum key.
 				 */
@@ -202,20 +356,14 @@ namespace ac
 				{
 					// Check if dictionary is empty
 					if ( mi_Length == 0 ) throw std::out_of_range("Cannot find max key on an empty dictionary.");
-					KeyComparator comp;
-					auto curr_max = mpt_Data[0].id;
-					for( auto i(0); i != mi_Length; ++i )
-					{
-						if ( not comp( mpt_Data[i].id, curr_max ) ) curr_max = mpt_Data[i].id;
-					}
-					return curr_max;
+					return ms_Data.key(mi_MaxPos);
 				}
 
 				/**
 				 * @brief      Given a key, iterates over the whole dictionary
-				 *             searching for the element which key is immediate
-				 *             successor of the one provided. Since this dictionary
-				 *             is not sorted, the search is linear.
+				 *             searching for the smallest key greater than the
+				 *             one provided, which need not be stored. Since this
+				 *             dictionary is not sorted, the search is linear.
 				 *
 				 * @param[in]  _x    Key provided by the user to find the successor.
 				 * @param      _y    Where the successor's key will be stored and
@@ -225,30 +373,25 @@ namespace ac
 				 */
 				bool successor ( const Key & _x, Key & _y ) const
 				{
-					if ( mi_Length == 0 ) return false;
-					// Check if the provided key is in dictionary
-					if ( _search(_x) == -1 ) return false;
-					
 					KeyComparator comp;
-					Key suc = max();
+					// If _x is not less than the max key, his successor would be out of the dictionary
+					if ( mi_Length == 0 or not comp( _x, ms_Data.key(mi_MaxPos) ) ) return false;
 
-					// If _x is equal to the max key, his successor would be out of the dictionary
-					if ( not comp(suc, _x) and not comp(_x, suc) ) return false;
-					
+					auto suc = mi_MaxPos;
 					// Iterating over the dictionary searching the immediate successor
 					for( auto i(0); i != mi_Length; ++i )
 					{	
-						if ( comp( _x, mpt_Data[i].id ) and comp( mpt_Data[i].id, suc ) )
-							suc = mpt_Data[i].id;
+						if ( comp( _x, ms_Data.key(i) ) and comp( ms_Data.key(i), ms_Data.key(suc) ) )
+							suc = i;
 					}
-					_y = suc;
+					_y = ms_Data.key(suc);
 					return true;
 				}
 
 				/**
 				 * @brief      Given a key, iterates over the whole dictionary
-				 *             searching for the element which key is immediate
-				 *             predecessor of the one provided. Since this
+				 *             searching for the greatest key less than the one
+				 *             provided, which need not be stored. Since this
 				 *             dictionary is not sorted, the search is linear.
 				 *
 				 * @param[in]  _x    Key provided by the user to find the
@@ -260,22 +403,17 @@ namespace ac
 				 */
 				bool predecessor ( const Key _x, Key & _y ) const
 				{
-					if ( mi_Length == 0 ) return false;
-					// Check if the provided key is in dictionary
-					if ( _search(_x) == -1 ) return false;
-					
 					KeyComparator comp;
-					Key pre = min();
+					// If _x is not greater than the min key, his predecessor would be out of the dictionary
+					if ( mi_Length == 0 or not comp( ms_Data.key(mi_MinPos), _x ) ) return false;
 
-					// If _x is equal to the min key, his predecessor would be out of the dictionary
-					if ( not comp(pre, _x) and not comp(_x, pre) ) return false;
-					
+					auto pre = mi_MinPos;
 					for( auto i(0); i != mi_Length; ++i )
 					{
-						if ( comp( mpt_Data[i].id, _x ) and comp( pre, mpt_Data[i].id ) )
-							pre = mpt_Data[i].id;
+						if ( comp( ms_Data.key(i), _x ) and comp( ms_Data.key(pre), ms_Data.key(i) ) )
+							pre = i;
 					}
-					_y = pre;
+					_y = ms_Data.key(pre);
 					return true;	
 				}
 
@@ -288,8 +426,8 @@ namespace ac
 				{
 					_os << "[ ";
 					for( int i(0); i < _oList.mi_Length; ++i )
-						_os << "{id: " << _oList.mpt_Data[i].id << ", info: "
-							<< _oList.mpt_Data[i].info << "} ";
+						_os << "{id: " << _oList.ms_Data.key(i) << ", info: "
+							<< _oList.ms_Data.info(i) << "} ";
 					_os << "]";
 					return _os;		
 				}
@@ -0,0 +1,667 @@
+/**
+ * @file    dbt.h
+ * @brief   Defining and implementing functions for DBT.
+ */
+
+#ifndef _DBT_H_
+#define _DBT_H_
+
+#include <algorithm>  // std::lower_bound, std::upper_bound, std::move
+#include <functional> // std::less
+#include <stdexcept>  // std::out_of_range
+#include <iostream>
+#include <iterator>   // std::next
+#include <vector>
+
+namespace ac
+{
+	/**
+	 * @brief      Class for Dictionary with B+Tree. Elements are stored in
+	 *             the leaves, which are linked in key order; inner nodes only
+	 *             route the searches. Nodes are sized to a few cache lines, so
+	 *             each level of the descent costs a handful of cache misses.
+	 *
+	 * @tparam     Key            Key of the element.
+	 * @tparam     Data           Value associated to the key.
+	 * @tparam     KeyComparator  Functor to compare keys.
+	 * @tparam     NodeBytes      Approximate size of a node, in bytes. Use a
+	 *                            multiple of the cache line (default) or a
+	 *                            page.
+	 */
+	template< typename Key, typename Data, typename KeyComparator = std::less<Key>, int NodeBytes = 256 >
+	class DBT
+	{
+		protected:
+
+			/**
+			 * @brief      Fields shared by leaves and inner nodes.
+			 */
+			struct Node
+			{
+				bool leaf;  // Whether the node is a leaf
+				int count;  // Number of keys stored in the node
+			};
+
+			// Number of keys that fit in each kind of node (at least 4, so splits are always possible)
+			static constexpr int LEAF_FIT = int( ( NodeBytes - sizeof(Node) - 2 * sizeof(void *) ) / ( sizeof(Key) + sizeof(Data) ) );
+			static constexpr int INNER_FIT = int( ( NodeBytes - sizeof(Node) - sizeof(void *) ) / ( sizeof(Key) + sizeof(void *) ) );
+			static constexpr int LEAF_MAX = LEAF_FIT < 4 ? 4 : LEAF_FIT;
+			static constexpr int INNER_MAX = INNER_FIT < 4 ? 4 : INNER_FIT;
+			static constexpr int LEAF_MIN = LEAF_MAX / 2;
+			static constexpr int INNER_MIN = INNER_MAX / 2;
+
+			/**
+			 * @brief      Leaf: keys and data side by side, plus the links to
+			 *             the neighbour leaves.
+			 */
+			struct Leaf : Node
+			{
+				Key keys[LEAF_MAX];
+				Data data[LEAF_MAX];
+				Leaf *prev;
+				Leaf *next;
+				Leaf() : prev(nullptr), next(nullptr) { this->leaf = true; this->count = 0; }
+			};
+
+			/**
+			 * @brief      Inner node: child[i] holds the keys less than keys[i],
+			 *             and child[i + 1] the keys not less than keys[i].
+			 */
+			struct Inner : Node
+			{
+				Key keys[INNER_MAX];
+				Node *child[INNER_MAX + 1];
+				Inner() { this->leaf = false; this->count = 0; }
+			};
+
+			int mi_Length;     // Number of elements stored
+			Node *mpt_Root;    // Root of the tree, never null
+			Leaf *mpt_Head;    // Leftmost leaf (minimum key)
+			Leaf *mpt_Tail;    // Rightmost leaf (maximum key)
+
+			/**
+			 * @brief      Auxiliar function that finds which child of an inner
+			 *             node may hold a key.
+			 */
+			static int _route ( const Inner *_n, const Key & _x )
+			{
+				return int( std::upper_bound( _n->keys, _n->keys + _n->count, _x, KeyComparator() ) - _n->keys );
+			}
+
+			/**
+			 * @brief      Auxiliar function that finds the position of the
+			 *             first key not less than _x in a leaf.
+			 */
+			static int _position ( const Leaf *_l, const Key & _x )
+			{
+				return int( std::lower_bound( _l->keys, _l->keys + _l->count, _x, KeyComparator() ) - _l->keys );
+			}
+
+			/**
+			 * @brief      Auxiliar function that descends to the leaf that may
+			 *             hold a key.
+			 */
+			Leaf * _find_leaf ( const Key & _x ) const
+			{
+				Node *n = mpt_Root;
+				while ( not n->leaf )
+				{
+					auto in = static_cast< Inner * >( n );
+					n = in->child[ _route( in, _x ) ];
+				}
+				return static_cast< Leaf * >( n );
+			}
+
+			/**
+			 * @brief      Auxiliar search. Finds the leaf and position where a
+			 *             key is stored.
+			 *
+			 * @param[in]  _x    Key of the element to be searched.
+			 * @param      _pos  Position of the key inside the leaf.
+			 *
+			 * @return     The leaf holding the key, or nullptr if not found.
+			 */
+			Leaf * _search ( const Key & _x, int & _pos ) const
+			{
+				KeyComparator comp;
+				auto l = _find_leaf( _x );
+				_pos = _position( l, _x );
+				if ( _pos == l->count or comp( _x, l->keys[_pos] ) ) return nullptr;
+				return l;
+			}
+
+			/**
+			 * @brief      Auxiliar recursive insertion. When the node splits,
+			 *             the new right sibling and its separator key are sent
+			 *             back to the parent.
+			 *
+			 * @param      _n         Subtree where the key goes.
+			 * @param[in]  _newKey    The key of the new element.
+			 * @param[in]  _newInfo   The data associated to the key.
+			 * @param      _sepKey    Separator of the new sibling, on split.
+			 * @param      _sibling   New right sibling, or nullptr if no split.
+			 *
+			 * @return     False if the key was already stored.
+			 */
+			bool _insert ( Node *_n, const Key & _newKey, const Data & _newInfo, Key & _sepKey, Node *& _sibling )
+			{
+				KeyComparator comp;
+				_sibling = nullptr;
+
+				if ( _n->leaf )
+				{
+					auto l = static_cast< Leaf * >( _n );
+					auto pos = _position( l, _newKey );
+					if ( pos != l->count and not comp( _newKey, l->keys[pos] ) ) return false;
+
+					if ( l->count == LEAF_MAX )
+					{
+						// Splits the leaf in half, then inserts in the proper half
+						auto r = new Leaf;
+						auto mid = LEAF_MAX / 2;
+						std::move( l->keys + mid, l->keys + LEAF_MAX, r->keys );
+						std::move( l->data + mid, l->data + LEAF_MAX, r->data );
+						r->count = LEAF_MAX - mid;
+						l->count = mid;
+						r->next = l->next;
+						r->prev = l;
+						if ( l->next ) l->next->prev = r;
+						else mpt_Tail = r;
+						l->next = r;
+						if ( pos > mid ) { l = r; pos -= mid; }
+						_sibling = r;
+					}
+
+					std::move_backward( l->keys + pos, l->keys + l->count, l->keys + l->count + 1 );
+					std::move_backward( l->data + pos, l->data + l->count, l->data + l->count + 1 );
+					l->keys[pos] = _newKey;
+					l->data[pos] = _newInfo;
+					l->count++;
+					if ( _sibling ) _sepKey = static_cast< Leaf * >( _sibling )->keys[0];
+					return true;
+				}
+
+				auto in = static_cast< Inner * >( _n );
+				auto i = _route( in, _newKey );
+				Key childKey;
+				Node *childSibling;
+				if ( not _insert( in->child[i], _newKey, _newInfo, childKey, childSibling ) ) return false;
+				if ( childSibling == nullptr ) return true;
+
+				if ( in->count < INNER_MAX )
+				{
+					std::move_backward( in->keys + i, in->keys + in->count, in->keys + in->count + 1 );
+					std::move_backward( in->child + i + 1, in->child + in->count + 1, in->child + in->count + 2 );
+					in->keys[i] = childKey;
+					in->child[i + 1] = childSibling;
+					in->count++;
+					return true;
+				}
+
+				// The inner node is full: lays out the INNER_MAX + 1 keys in order and splits them,
+				// promoting the middle key to the parent
+				Key keys[INNER_MAX + 1];
+				Node *child[INNER_MAX + 2];
+				std::move( in->keys, in->keys + i, keys );
+				keys[i] = childKey;
+				std::move( in->keys + i, in->keys + INNER_MAX, keys + i + 1 );
+				std::copy( in->child, in->child + i + 1, child );
+				child[i + 1] = childSibling;
+				std::copy( in->child + i + 1, in->child + INNER_MAX + 1, child + i + 2 );
+
+				auto mid = ( INNER_MAX + 1 ) / 2;
+				auto r = new Inner;
+				std::move( keys, keys + mid, in->keys );
+				std::copy( child, child + mid + 1, in->child );
+				in->count = mid;
+				std::move( keys + mid + 1, keys + INNER_MAX + 1, r->keys );
+				std::copy( child + mid + 1, child + INNER_MAX + 2, r->child );
+				r->count = INNER_MAX - mid;
+				_sepKey = keys[mid];
+				_sibling = r;
+				return true;
+			}
+
+			/**
+			 * @brief      Auxiliar function that fixes child i of an inner
+			 *             node after it fell below the minimum occupancy, by
+			 *             borrowing one key from a sibling or merging with it.
+			 */
+			void _fix_child ( Inner *_p, int _i )
+			{
+				if ( _p->child[_i]->leaf )
+				{
+					auto c = static_cast< Leaf * >( _p->child[_i] );
+					auto left = _i > 0 ? static_cast< Leaf * >( _p->child[_i - 1] ) : nullptr;
+					auto right = _i < _p->count ? static_cast< Leaf * >( _p->child[_i + 1] ) : nullptr;
+
+					if ( left and left->count > LEAF_MIN )
+					{
+						std::move_backward( c->keys, c->keys + c->count, c->keys + c->count + 1 );
+						std::move_backward( c->data, c->data + c->count, c->data + c->count + 1 );
+						c->keys[0] = std::move( left->keys[left->count - 1] );
+						c->data[0] = std::move( left->data[left->count - 1] );
+						left->count--; c->count++;
+						_p->keys[_i - 1] = c->keys[0];
+					}
+					else if ( right and right->count > LEAF_MIN )
+					{
+						c->keys[c->count] = std::move( right->keys[0] );
+						c->data[c->count] = std::move( right->data[0] );
+						std::move( right->keys + 1, right->keys + right->count, right->keys );
+						std::move( right->data + 1, right->data + right->count, right->data );
+						right->count--; c->count++;
+						_p->keys[_i] = right->keys[0];
+					}
+					else
+					{
+						// Merges the right one of the pair into the left one
+						auto j = left ? _i - 1 : _i;
+						auto l = static_cast< Leaf * >( _p->child[j] );
+						auto r = static_cast< Leaf * >( _p->child[j + 1] );
+						std::move( r->keys, r->keys + r->count, l->keys + l->count );
+						std::move( r->data, r->data + r->count, l->data + l->count );
+						l->count += r->count;
+						l->next = r->next;
+						if ( r->next ) r->next->prev = l;
+						else mpt_Tail = l;
+						delete r;
+						_remove_separator( _p, j );
+					}
+					return;
+				}
+
+				auto c = static_cast< Inner * >( _p->child[_i] );
+				auto left = _i > 0 ? static_cast< Inner * >( _p->child[_i - 1] ) : nullptr;
+				auto right = _i < _p->count ? static_cast< Inner * >( _p->child[_i + 1] ) : nullptr;
+
+				if ( left and left->count > INNER_MIN )
+				{
+					std::move_backward( c->keys, c->keys + c->count, c->keys + c->count + 1 );
+					std::move_backward( c->child, c->child + c->count + 1, c->child + c->count + 2 );
+					c->keys[0] = std::move( _p->keys[_i - 1] );
+					c->child[0] = left->child[left->count];
+					_p->keys[_i - 1] = std::move( left->keys[left->count - 1] );
+					left->count--; c->count++;
+				}
+				else if ( right and right->count > INNER_MIN )
+				{
+					c->keys[c->count] = std::move( _p->keys[_i] );
+					c->child[c->count + 1] = right->child[0];
+					_p->keys[_i] = std::move( right->keys[0] );
+					std::move( right->keys + 1, right->keys + right->count, right->keys );
+					std::move( right->child + 1, right->child + right->count + 1, right->child );
+					right->count--; c->count++;
+				}
+				else
+				{
+					// Merges the right one of the pair into the left one, pulling down the separator
+					auto j = left ? _i - 1 : _i;
+					auto l = static_cast< Inner * >( _p->child[j] );
+					auto r = static_cast< Inner * >( _p->child[j + 1] );
+					l->keys[l->count] = std::move( _p->keys[j] );
+					std::move( r->keys, r->keys + r->count, l->keys + l->count + 1 );
+					std::copy( r->child, r->child + r->count + 1, l->child + l->count + 1 );
+					l->count += r->count + 1;
+					delete r;
+					_remove_separator( _p, j );
+				}
+			}
+
+			/**
+			 * @brief      Auxiliar function that removes keys[j] and child[j+1]
+			 *             from an inner node, after a merge.
+			 */
+			static void _remove_separator ( Inner *_p, int _j )
+			{
+				std::move( _p->keys + _j + 1, _p->keys + _p->count, _p->keys + _j );
+				std::copy( _p->child + _j + 2, _p->child + _p->count + 1, _p->child + _j + 1 );
+				_p->count--;
+			}
+
+			/**
+			 * @brief      Auxiliar recursive removal. Rebalances the children
+			 *             on the way back up.
+			 *
+			 * @return     True if able to remove element, false otherwise.
+			 */
+			bool _remove ( Node *_n, const Key & _x, Data & _s )
+			{
+				KeyComparator comp;
+				if ( _n->leaf )
+				{
+					auto l = static_cast< Leaf * >( _n );
+					auto pos = _position( l, _x );
+					if ( pos == l->count or comp( _x, l->keys[pos] ) ) return false;
+					_s = l->data[pos];
+					std::move( l->keys + pos + 1, l->keys + l->count, l->keys + pos );
+					std::move( l->data + pos + 1, l->data + l->count, l->data + pos );
+					l->count--;
+					return true;
+				}
+
+				auto in = static_cast< Inner * >( _n );
+				auto i = _route( in, _x );
+				if ( not _remove( in->child[i], _x, _s ) ) return false;
+				auto min = in->child[i]->leaf ? LEAF_MIN : INNER_MIN;
+				if ( in->child[i]->count < min ) _fix_child( in, i );
+				return true;
+			}
+
+			/**
+			 * @brief      Auxiliar function that frees a subtree.
+			 */
+			static void _destroy ( Node *_n )
+			{
+				if ( not _n->leaf )
+				{
+					auto in = static_cast< Inner * >( _n );
+					for ( auto i(0); i <= in->count; ++i ) _destroy( in->child[i] );
+					delete in;
+				}
+				else delete static_cast< Leaf * >( _n );
+			}
+
+		public:
+
+			/**
+			 * @brief      Default constructor. Creates an empty tree.
+			 */
+			DBT ( void )
+				: mi_Length(0)
+				, mpt_Root( new Leaf )
+			{
+				mpt_Head = mpt_Tail = static_cast< Leaf * >( mpt_Root );
+			}
+
+			DBT ( const DBT & ) = delete;
+			DBT & operator= ( const DBT & ) = delete;
+
+			/**
+			 * @brief      Destroys the object.
+			 */
+			virtual ~DBT () { _destroy( mpt_Root ); }
+
+			/**
+			 * @brief      Removes every element of the dictionary.
+			 */
+			void clear ( void )
+			{
+				_destroy( mpt_Root );
+				mpt_Root = mpt_Head = mpt_Tail = new Leaf;
+				mi_Length = 0;
+			}
+
+			/**
+			 * @brief      Retrieves how many elements are stored in the
+			 *             dictionary.
+			 *
+			 * @return     Number of elements.
+			 */
+			int size ( void ) const
+			{
+				return mi_Length;
+			}
+
+			/**
+			 * @brief      Checks if the dictionary is empty or not.
+			 *
+			 * @return     True if no elements are stored in the dictionary.
+			 *             False otherwise.
+			 */
+			bool empty ( void ) const
+			{
+				return mi_Length == 0;
+			}
+
+			/**
+			 * @brief      Removes an element of this dictionary by its key.
+			 *
+			 * @param[in]  _x    Key provided by the client for the element to
+			 *                   be removed.
+			 * @param      _s    If the key was found, its data will be
+			 *                   retrieved inside _s.
+			 *
+			 * @return     True if able to remove element. False otherwise.
+			 */
+			bool remove ( const Key & _x, Data & _s )
+			{
+				if ( empty() ) return false;
+				if ( not _remove( mpt_Root, _x, _s ) ) return false;
+				mi_Length--;
+
+				// The root loses a level when left with a single child
+				if ( not mpt_Root->leaf and mpt_Root->count == 0 )
+				{
+					auto old = static_cast< Inner * >( mpt_Root );
+					mpt_Root = old->child[0];
+					delete old;
+				}
+				return true;
+			}
+
+			/**
+			 * @brief      Searches for the match on a key provided by the
+			 *             client.
+			 *
+			 * @param[in]  _x    Key provided by the client to search element.
+			 * @param      _s    Where the information about the found element
+			 *                   will be stored.
+			 *
+			 * @return     True if able to find element. False otherwise.
+			 */
+			bool search ( const Key & _x, Data & _s ) const
+			{
+				int pos;
+				auto l = _search( _x, pos );
+				if ( l == nullptr ) return false;
+				_s = l->data[pos];
+				return true;
+			}
+
+			/**
+			 * @brief      Inserts a new element inside the dictionary.
+			 *
+			 * @param[in]  _newKey   The key of the new element to be inserted.
+			 * @param[in]  _newInfo  The data associated to the key.
+			 *
+			 * @return     True if able to insert, false if the key was
+			 *             already stored.
+			 */
+			bool insert ( const Key & _newKey, const Data & _newInfo )
+			{
+				Key sepKey;
+				Node *sibling;
+				if ( not _insert( mpt_Root, _newKey, _newInfo, sepKey, sibling ) ) return false;
+				mi_Length++;
+
+				// The root split: the tree grows one level
+				if ( sibling )
+				{
+					auto root = new Inner;
+					root->keys[0] = sepKey;
+					root->child[0] = mpt_Root;
+					root->child[1] = sibling;
+					root->count = 1;
+					mpt_Root = root;
+				}
+				return true;
+			}
+
+			/**
+			 * @brief      Replaces the content of the dictionary with the
+			 *             pairs of a range sorted by key, building the tree
+			 *             bottom-up with full leaves in a single pass.
+			 *
+			 * @param[in]  first     Where the range begins.
+			 * @param[in]  last      Where the range ends.
+			 *
+			 * @tparam     InputItr  Forward iterator to std::pair<Key, Data>.
+			 *
+			 * @return     True if loaded. False if the keys are not strictly
+			 *             increasing, in which case the dictionary is left
+			 *             untouched.
+			 */
+			template< typename InputItr >
+			bool bulk_load ( InputItr first, InputItr last )
+			{
+				KeyComparator comp;
+				if ( first != last )
+				{
+					auto prev = first;
+					for ( auto it = std::next( first ); it != last; ++it, ++prev )
+						if ( not comp( prev -> first, it -> first ) ) return false;
+				}
+
+				clear();
+				if ( first == last ) return true;
+				delete mpt_Root;
+
+				// Leaves, linked in order. The last two are balanced so none is below the minimum.
+				std::vector< Node * > level;
+				std::vector< Key > lows; // Smallest key under each node of the level
+				Leaf *l = nullptr;
+				for ( auto it = first; it != last; ++it )
+				{
+					if ( l == nullptr or l->count == LEAF_MAX )
+					{
+						auto n = new Leaf;
+						n->prev = l;
+						if ( l ) l->next = n;
+						l = n;
+						level.push_back( l );
+						lows.push_back( it -> first );
+					}
+					l->keys[l->count] = it -> first;
+					l->data[l->count] = it -> second;
+					l->count++;
+					mi_Length++;
+				}
+				mpt_Head = static_cast< Leaf * >( level.front() );
+				mpt_Tail = l;
+				if ( l->prev and l->count < LEAF_MIN )
+				{
+					auto p = l->prev;
+					auto move = LEAF_MIN - l->count;
+					std::move_backward( l->keys, l->keys + l->count, l->keys + l->count + move );
+					std::move_backward( l->data, l->data + l->count, l->data + l->count + move );
+					std::move( p->keys + p->count - move, p->keys + p->count, l->keys );
+					std::move( p->data + p->count - move, p->data + p->count, l->data );
+					p->count -= move;
+					l->count += move;
+					lows.back() = l->keys[0];
+				}
+
+				// Inner levels, bottom-up, until a single root is left
+				while ( level.size() > 1 )
+				{
+					std::vector< Node * > up;
+					std::vector< Key > upLows;
+					std::size_t total = level.size();
+					std::size_t i = 0;
+					while ( i < total )
+					{
+						std::size_t take = std::min< std::size_t >( INNER_MAX + 1, total - i );
+						// Leaves enough children for the last node to reach the minimum
+						std::size_t rest = total - i - take;
+						if ( rest > 0 and rest < INNER_MIN + 1 ) take -= INNER_MIN + 1 - rest;
+						auto in = new Inner;
+						for ( std::size_t c = 0; c < take; ++c )
+						{
+							in->child[c] = level[i + c];
+							if ( c > 0 ) in->keys[c - 1] = lows[i + c];
+						}
+						in->count = int( take ) - 1;
+						up.push_back( in );
+						upLows.push_back( lows[i] );
+						i += take;
+					}
+					level.swap( up );
+					lows.swap( upLows );
+				}
+				mpt_Root = level.front();
+				return true;
+			}
+
+			/**
+			 * @brief      Finds the minimum key, at the beginning of the
+			 *             leftmost leaf.
+			 *
+			 * @return     The minimum key.
+			 */
+			Key min () const
+			{
+				if ( mi_Length == 0 ) throw std::out_of_range("Cannot find min key on an empty dictionary.");
+				return mpt_Head->keys[0];
+			}
+
+			/**
+			 * @brief      Finds the maximum key, at the ending of the
+			 *             rightmost leaf.
+			 *
+			 * @return     The maximum key.
+			 */
+			Key max () const
+			{
+				if ( mi_Length == 0 ) throw std::out_of_range("Cannot find max key on an empty dictionary.");
+				return mpt_Tail->keys[mpt_Tail->count - 1];
+			}
+
+			/**
+			 * @brief      Finds the smallest key greater than the one provided
+			 *             by the client, following the leaf links when
+			 *             needed. The provided key need not be stored.
+			 *
+			 * @param[in]  _x    Key to find its successor.
+			 * @param      _y    Where the successor's key will be stored.
+			 *
+			 * @return     True if able to find a successor. False otherwise.
+			 */
+			bool successor ( const Key & _x, Key & _y ) const
+			{
+				auto l = _find_leaf( _x );
+				auto pos = int( std::upper_bound( l->keys, l->keys + l->count, _x, KeyComparator() ) - l->keys );
+				if ( pos < l->count ) { _y = l->keys[pos]; return true; }
+				if ( l->next == nullptr ) return false;
+				_y = l->next->keys[0];
+				return true;
+			}
+
+			/**
+			 * @brief      Finds the greatest key less than the one provided by
+			 *             the client, following the leaf links when needed.
+			 *             The provided key need not be stored.
+			 *
+			 * @param[in]  _x    Key to find its predecessor.
+			 * @param      _y    Where the predecessor's key will be stored.
+			 *
+			 * @return     True if able to find a predecessor. False otherwise.
+			 */
+			bool predecessor ( const Key & _x, Key & _y ) const
+			{
+				auto l = _find_leaf( _x );
+				auto pos = _position( l, _x );
+				if ( pos > 0 ) { _y = l->keys[pos - 1]; return true; }
+				if ( l->prev == nullptr ) return false;
+				_y = l->prev->keys[l->prev->count - 1];
+				return true;
+			}
+
+			/**
+			 * @brief      Overloading stream operator to print the dictionary's
+			 *             elements in key order.
+			 */
+			inline friend
+			std::ostream &operator<< ( std::ostream& _os, const DBT& _oTree )
+			{
+				_os << "[ ";
+				for ( auto l = _oTree.mpt_Head; l != nullptr and l->count > 0; l = l->next )
+					for ( auto i(0); i < l->count; ++i )
+						_os << "{id: " << l->keys[i] << ", info: " << l->data[i] << "} ";
+				_os << "]";
+				return _os;
+			}
+	};
+}
+
+#endif
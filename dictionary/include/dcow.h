@@ -0,0 +1,147 @@
+/**
+ * @file    dcow.h
+ * @brief   Defining and implementing functions for DCOW.
+ */
+
+#ifndef _DCOW_H_
+#define _DCOW_H_
+
+#include <functional> // std::less
+#include <iostream>
+#include <memory>     // std::shared_ptr, std::atomic_load, std::atomic_store
+#include <mutex>      // std::mutex, std::lock_guard
+
+#include "dsal.h"
+
+namespace ac
+{
+	/**
+	 * @brief      Class for Dictionary with Copy-On-Write snapshots of a
+	 *             DSAL, for many reader threads and few updates. Readers take
+	 *             the current version with an atomic load of a shared
+	 *             pointer and never wait for the writers; a writer copies the
+	 *             current version, applies its changes to the copy and
+	 *             publishes it with an atomic store. A version is freed when
+	 *             the last snapshot of it is dropped. Each update copies the
+	 *             whole array, so several changes should go in one update().
+	 *
+	 * @tparam     Key            Key of the element.
+	 * @tparam     Data           Value associated to the key.
+	 * @tparam     KeyComparator  Functor to compare keys.
+	 * @tparam     Layout         AoS (default) or SoA, see DAL.
+	 */
+	template< typename Key, typename Data, typename KeyComparator = std::less<Key>, typename Layout = AoS >
+	class DCOW
+	{
+		public:
+
+			using Dict = DSAL< Key, Data, KeyComparator, Layout >;
+			using Snapshot = std::shared_ptr< const Dict >; //!< Immutable version of the dictionary.
+
+			/**
+			 * @brief      Default constructor. Publishes an empty version.
+			 */
+			DCOW ( void ) : mp_Current( std::make_shared< const Dict >() ) { /* empty */ }
+
+			DCOW ( const DCOW & ) = delete;
+			DCOW & operator= ( const DCOW & ) = delete;
+
+			/**
+			 * @brief      Takes the current version. It stays valid, and
+			 *             unchanged, for as long as the client keeps it.
+			 *             Safe to call from any thread.
+			 *
+			 * @return     The current version.
+			 */
+			Snapshot snapshot ( void ) const
+			{
+				return std::atomic_load( &mp_Current );
+			}
+
+			/**
+			 * @brief      Applies a batch of changes as a single new version:
+			 *             copies the current one, calls _f on the copy and
+			 *             publishes it. Readers see every change of the
+			 *             batch or none. Writers wait for each other.
+			 *
+			 * @param[in]  _f    Called with a DSAL & to the copy.
+			 *
+			 * @tparam     Func  Callable with a DSAL &.
+			 */
+			template< typename Func >
+			void update ( Func _f )
+			{
+				std::lock_guard< std::mutex > lock( m_Writer );
+				std::shared_ptr< Dict > next = std::make_shared< Dict >( *std::atomic_load( &mp_Current ) );
+				_f( *next );
+				// Readers share the version from now on, so its read structures are built here
+				next->prepare_reads();
+				std::atomic_store( &mp_Current, Snapshot( std::move( next ) ) );
+			}
+
+			/**
+			 * @brief      Inserts a key and its associate value as a new
+			 *             version. See update() for batches.
+			 *
+			 * @return     True if able to insert the key-data. False otherwise.
+			 */
+			bool insert ( const Key & _newKey, const Data & _newInfo )
+			{
+				bool inserted = false;
+				update( [&]( Dict & _d ) { inserted = _d.insert( _newKey, _newInfo ); } );
+				return inserted;
+			}
+
+			/**
+			 * @brief      Removes an element by its key as a new version. See
+			 *             update() for batches.
+			 *
+			 * @return     True if able to remove element. False otherwise.
+			 */
+			bool remove ( const Key & _x, Data & _s )
+			{
+				bool removed = false;
+				update( [&]( Dict & _d ) { removed = _d.remove( _x, _s ); } );
+				return removed;
+			}
+
+			/**
+			 * @brief      Publishes an empty version.
+			 */
+			void clear ( void )
+			{
+				std::lock_guard< std::mutex > lock( m_Writer );
+				std::atomic_store( &mp_Current, Snapshot( std::make_shared< const Dict >() ) );
+			}
+
+			/**
+			 * @brief      The reads below work on the current version. For
+			 *             several reads that must agree with each other, take
+			 *             a snapshot() and read it instead.
+			 */
+			bool search ( const Key & _x, Data & _s ) const { return snapshot()->search( _x, _s ); }
+			bool successor ( const Key & _x, Key & _y ) const { return snapshot()->successor( _x, _y ); }
+			bool predecessor ( const Key & _x, Key & _y ) const { return snapshot()->predecessor( _x, _y ); }
+			Key min ( void ) const { return snapshot()->min(); }
+			Key max ( void ) const { return snapshot()->max(); }
+			int size ( void ) const { return snapshot()->size(); }
+			bool empty ( void ) const { return snapshot()->empty(); }
+
+			/**
+			 * @brief      Overloading stream operator to print the current
+			 *             version.
+			 */
+			inline friend
+			std::ostream &operator<< ( std::ostream& _os, const DCOW& _oCow )
+			{
+				return _os << *_oCow.snapshot();
+			}
+
+		private:
+
+			Snapshot mp_Current; // Current version, only accessed with the atomic shared_ptr functions
+			std::mutex m_Writer; // Serializes the writers
+	};
+}
+
+#endif
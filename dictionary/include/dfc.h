@@ -0,0 +1,532 @@
+/**
+ * @file    dfc.h
+ * @brief   Defining and implementing functions for DFC.
+ */
+
+#ifndef _DFC_H_
+#define _DFC_H_
+
+#include <algorithm>  // std::copy, std::lower_bound, std::stable_sort, std::unique
+#include <cstddef>    // std::size_t
+#include <iostream>
+#include <iterator>   // std::next
+#include <stdexcept>  // std::out_of_range
+#include <string>
+#include <utility>    // std::pair
+#include <vector>
+
+namespace ac
+{
+	/**
+	 * @brief      Class for Dictionary with Front Coding: a sorted dictionary
+	 *             of std::string keys (in std::less order) that stores the
+	 *             keys front coded in one contiguous buffer. The keys are
+	 *             grouped in blocks of BlockSize to 2 * BlockSize keys; in a
+	 *             block, each key is written as the length of the prefix it
+	 *             shares with the previous key and the rest of its bytes, so
+	 *             keys with long common prefixes take a few bytes each and
+	 *             no string has its own heap buffer. Searches bisect the first
+	 *             keys of the blocks, which are stored whole, and decode one
+	 *             block. Like DSAL, insertions and removals move the tail of
+	 *             the buffer.
+	 *
+	 * @tparam     Data       Value associated to the key.
+	 * @tparam     BlockSize  Keys per block after a split. Larger blocks
+	 *                        compress better and decode slower.
+	 */
+	template< typename Data, int BlockSize = 16 >
+	class DFC
+	{
+		static_assert( BlockSize >= 2, "Blocks must hold at least 2 keys." );
+
+		protected:
+
+			/**
+			 * @brief      Where a block is in the buffer, and which keys it
+			 *             has.
+			 */
+			struct Block
+			{
+				int offset; // First byte of the block in mv_Bytes
+				int bytes;  // Bytes of the block
+				int count;  // Keys in the block
+				int first;  // Position, in key order, of its first key
+			};
+
+			std::vector< char > mv_Bytes;	// Blocks of front coded keys, one after another
+			std::vector< Block > mv_Blocks;	// Blocks, in key order
+			std::vector< Data > mv_Info;	// Data, in key order
+			int mi_Length;					// Number of keys
+
+			/**
+			 * @brief      Writes an unsigned integer with 7 bits per byte,
+			 *             the high bit telling if more bytes follow.
+			 */
+			static void _put ( std::vector< char > & _out, std::size_t _v )
+			{
+				while ( _v >= 0x80 )
+				{
+					_out.push_back( char( ( _v & 0x7f ) | 0x80 ) );
+					_v >>= 7;
+				}
+				_out.push_back( char( _v ) );
+			}
+
+			/**
+			 * @brief      Reads an integer written by _put(), advancing _p.
+			 */
+			static std::size_t _get ( const char *& _p )
+			{
+				std::size_t v(0);
+				int shift(0);
+				unsigned char byte;
+				do
+				{
+					byte = static_cast< unsigned char >( *_p++ );
+					v |= std::size_t( byte & 0x7f ) << shift;
+					shift += 7;
+				} while ( byte & 0x80 );
+				return v;
+			}
+
+			/**
+			 * @brief      Appends keys [_first, _last) to _out as one block:
+			 *             for each key, the length of the prefix shared with
+			 *             the previous key (0 for the first), the length of
+			 *             the rest and the rest.
+			 */
+			static void _encode ( const std::string *_first, const std::string *_last, std::vector< char > & _out )
+			{
+				const std::string *prev = nullptr;
+				for ( auto k = _first; k != _last; prev = k++ )
+				{
+					std::size_t shared(0);
+					if ( prev != nullptr )
+						while ( shared < prev->size() and shared < k->size() and ( *prev )[shared] == ( *k )[shared] ) ++shared;
+					_put( _out, shared );
+					_put( _out, k->size() - shared );
+					_out.insert( _out.end(), k->begin() + shared, k->end() );
+				}
+			}
+
+			/**
+			 * @brief      Decodes every key of a block.
+			 */
+			void _decode ( int _b, std::vector< std::string > & _keys ) const
+			{
+				const char *p = mv_Bytes.data() + mv_Blocks[_b].offset;
+				std::string cur;
+				for ( auto i(0); i < mv_Blocks[_b].count; ++i )
+				{
+					_next( p, cur );
+					_keys.push_back( cur );
+				}
+			}
+
+			/**
+			 * @brief      Decodes the key at _p over the previous key in
+			 *             _cur, advancing _p.
+			 */
+			static void _next ( const char *& _p, std::string & _cur )
+			{
+				auto shared = _get( _p );
+				auto rest = _get( _p );
+				_cur.resize( shared );
+				_cur.append( _p, rest );
+				_p += rest;
+			}
+
+			/**
+			 * @brief      Compares the first key of a block, in place, with
+			 *             _x.
+			 *
+			 * @return     Negative, zero or positive, as std::string::compare.
+			 */
+			int _compare_head ( int _b, const std::string & _x ) const
+			{
+				const char *p = mv_Bytes.data() + mv_Blocks[_b].offset;
+				_get( p ); // Nothing shared
+				auto size = _get( p );
+				return -_x.compare( 0, _x.size(), p, size );
+			}
+
+			/**
+			 * @brief      Auxiliary binary search over the first keys of the
+			 *             blocks.
+			 *
+			 * @return     The last block whose first key is not greater than
+			 *             _x, or 0 if there is none. -1 if empty.
+			 */
+			int _find_block ( const std::string & _x ) const
+			{
+				int left(0), right( int( mv_Blocks.size() ) );
+				while ( left < right )
+				{
+					int mid = left + ( right - left ) / 2;
+					if ( _compare_head( mid, _x ) <= 0 ) left = mid + 1;
+					else right = mid;
+				}
+				return std::max( left - 1, mv_Blocks.empty() ? -1 : 0 );
+			}
+
+			/**
+			 * @brief      Auxiliary function that replaces _n blocks, from
+			 *             _b on, with the given sorted keys: one block, two
+			 *             halves if there are more than 2 * BlockSize keys,
+			 *             or none if there are no keys. Moves the tail of the
+			 *             buffer once and updates the blocks after them.
+			 */
+			void _rewrite ( int _b, int _n, const std::vector< std::string > & _keys )
+			{
+				std::vector< char > bytes;
+				std::vector< Block > fresh;
+				int first = mv_Blocks[_b].first;
+				int offset = mv_Blocks[_b].offset;
+				int old_bytes = mv_Blocks[_b + _n - 1].offset + mv_Blocks[_b + _n - 1].bytes - offset;
+
+				int parts = _keys.empty() ? 0 : ( int( _keys.size() ) > 2 * BlockSize ? 2 : 1 );
+				for ( auto p(0); p < parts; ++p )
+				{
+					int from = int( _keys.size() ) * p / parts, to = int( _keys.size() ) * ( p + 1 ) / parts;
+					Block block;
+					block.offset = offset + int( bytes.size() );
+					_encode( _keys.data() + from, _keys.data() + to, bytes );
+					block.bytes = offset + int( bytes.size() ) - block.offset;
+					block.count = to - from;
+					block.first = first + from;
+					fresh.push_back( block );
+				}
+
+				// Opens or closes the gap in the buffer, then writes the new blocks
+				int new_bytes = int( bytes.size() );
+				auto at = mv_Bytes.begin() + offset;
+				if ( new_bytes >= old_bytes ) mv_Bytes.insert( at + old_bytes, new_bytes - old_bytes, 0 );
+				else mv_Bytes.erase( at + new_bytes, at + old_bytes );
+				std::copy( bytes.begin(), bytes.end(), mv_Bytes.begin() + offset );
+
+				mv_Blocks.erase( mv_Blocks.begin() + _b, mv_Blocks.begin() + _b + _n );
+				mv_Blocks.insert( mv_Blocks.begin() + _b, fresh.begin(), fresh.end() );
+				for ( auto b = _b + int( fresh.size() ); b < int( mv_Blocks.size() ); ++b )
+				{
+					mv_Blocks[b].offset += new_bytes - old_bytes;
+					mv_Blocks[b].first = b == 0 ? 0 : mv_Blocks[b - 1].first + mv_Blocks[b - 1].count;
+				}
+			}
+
+		public:
+
+			/**
+			 * @brief      Default constructor. Creates an empty dictionary.
+			 */
+			DFC ( void ) : mi_Length(0) { /* empty */ }
+
+			/**
+			 * @brief      Retrieves how many elements are stored in the
+			 *             dictionary.
+			 *
+			 * @return     Number of elements.
+			 */
+			int size ( void ) const
+			{
+				return mi_Length;
+			}
+
+			/**
+			 * @brief      Checks if the dictionary is empty or not.
+			 *
+			 * @return     True if no elements are stored in the dictionary.
+			 *             False otherwise.
+			 */
+			bool empty ( void ) const
+			{
+				return mi_Length == 0;
+			}
+
+			/**
+			 * @brief      Removes every element of the dictionary.
+			 */
+			void clear ( void )
+			{
+				mv_Bytes.clear();
+				mv_Blocks.clear();
+				mv_Info.clear();
+				mi_Length = 0;
+			}
+
+			/**
+			 * @brief      Memory taken by the dictionary: its buffers, at
+			 *             their capacity, and the object itself.
+			 *
+			 * @return     Bytes.
+			 */
+			std::size_t memory_usage ( void ) const
+			{
+				return sizeof( *this ) + mv_Bytes.capacity() + mv_Blocks.capacity() * sizeof( Block )
+					+ mv_Info.capacity() * sizeof( Data );
+			}
+
+			/**
+			 * @brief      Searches for the match on a key provided by the
+			 *             client, decoding one block until the key is passed.
+			 *
+			 * @param[in]  _x    Key provided by the client to search element.
+			 * @param      _s    Where the information about the found element
+			 *                   will be stored and used by the client.
+			 *
+			 * @return     True if able to find element. False otherwise.
+			 */
+			bool search ( const std::string & _x, Data & _s ) const
+			{
+				auto b = _find_block( _x );
+				if ( b < 0 ) return false;
+				const char *p = mv_Bytes.data() + mv_Blocks[b].offset;
+				std::string cur;
+				for ( auto i(0); i < mv_Blocks[b].count; ++i )
+				{
+					_next( p, cur );
+					auto cmp = cur.compare( _x );
+					if ( cmp == 0 ) { _s = mv_Info[ mv_Blocks[b].first + i ]; return true; }
+					if ( cmp > 0 ) return false;
+				}
+				return false;
+			}
+
+			/**
+			 * @brief      Inserts a key and its associate value in this
+			 *             dictionary, re-encoding its block (split in two
+			 *             if it gets larger than 2 * BlockSize keys).
+			 *
+			 * @param[in]  _newKey   The new key to be added.
+			 * @param[in]  _newInfo  The associated information.
+			 *
+			 * @return     True if able to insert the key-data. False if the
+			 *             key is already stored.
+			 */
+			bool insert ( const std::string & _newKey, const Data & _newInfo )
+			{
+				// An empty dictionary gets an empty block to insert into
+				if ( mv_Blocks.empty() )
+				{
+					Block block = { 0, 0, 0, 0 };
+					mv_Blocks.push_back( block );
+				}
+				auto b = mi_Length == 0 ? 0 : _find_block( _newKey );
+				std::vector< std::string > keys;
+				_decode( b, keys );
+				auto it = std::lower_bound( keys.begin(), keys.end(), _newKey );
+				if ( it != keys.end() and *it == _newKey ) return false;
+
+				auto pos = int( it - keys.begin() );
+				keys.insert( it, _newKey );
+				mv_Info.insert( mv_Info.begin() + mv_Blocks[b].first + pos, _newInfo );
+				mi_Length += 1;
+				_rewrite( b, 1, keys );
+				return true;
+			}
+
+			/**
+			 * @brief      Removes an element of this dictionary by its key,
+			 *             re-encoding its block (merged with the next one, or
+			 *             with the previous one if it is the last block, if
+			 *             it gets smaller than BlockSize / 2 keys and both
+			 *             fit in one).
+			 *
+			 * @param[in]  _x    Key provided by the client for the element to
+			 *                   be removed.
+			 * @param      _s    If the key was found, its data will be
+			 *                   retrieved inside _s.
+			 *
+			 * @return     True if able to remove element. False otherwise.
+			 */
+			bool remove ( const std::string & _x, Data & _s )
+			{
+				auto b = _find_block( _x );
+				if ( b < 0 ) return false;
+				std::vector< std::string > keys;
+				_decode( b, keys );
+				auto it = std::lower_bound( keys.begin(), keys.end(), _x );
+				if ( it == keys.end() or *it != _x ) return false;
+
+				auto at = mv_Info.begin() + mv_Blocks[b].first + ( it - keys.begin() );
+				_s = *at;
+				mv_Info.erase( at );
+				keys.erase( it );
+				mi_Length -= 1;
+
+				int n(1);
+				if ( int( keys.size() ) < BlockSize / 2 )
+				{
+					if ( b + 1 < int( mv_Blocks.size() ) and int( keys.size() ) + mv_Blocks[b + 1].count <= 2 * BlockSize )
+					{
+						_decode( b + 1, keys );
+						n = 2;
+					}
+					else if ( b + 1 == int( mv_Blocks.size() ) and b > 0
+							  and int( keys.size() ) + mv_Blocks[b - 1].count <= 2 * BlockSize )
+					{
+						// The last block has no next one: merged with the previous block
+						std::vector< std::string > merged;
+						_decode( b - 1, merged );
+						merged.insert( merged.end(), keys.begin(), keys.end() );
+						keys.swap( merged );
+						b -= 1;
+						n = 2;
+					}
+				}
+				_rewrite( b, n, keys );
+				return true;
+			}
+
+			/**
+			 * @brief      Replaces the content of this dictionary with the
+			 *             pairs of a range, encoded in a single pass. If the
+			 *             range is not sorted by key, a sorted copy is made
+			 *             first; for repeated keys the first occurrence is
+			 *             kept, as if insert() was called for each pair in
+			 *             order.
+			 *
+			 * @param[in]  first     Where the range begins.
+			 * @param[in]  last      Where the range ends.
+			 *
+			 * @tparam     InputItr  Forward iterator to
+			 *                       std::pair<std::string, Data>.
+			 */
+			template< typename InputItr >
+			void bulk_load ( InputItr first, InputItr last )
+			{
+				using Pair = std::pair< std::string, Data >;
+				std::vector< Pair > batch( first, last );
+				auto by_key = []( const Pair & a, const Pair & b ) { return a.first < b.first; };
+				auto same_key = []( const Pair & a, const Pair & b ) { return a.first == b.first; };
+				std::stable_sort( batch.begin(), batch.end(), by_key );
+				batch.erase( std::unique( batch.begin(), batch.end(), same_key ), batch.end() );
+
+				clear();
+				std::vector< std::string > keys;
+				keys.reserve( batch.size() );
+				mv_Info.reserve( batch.size() );
+				for ( auto & p : batch ) { keys.push_back( p.first ); mv_Info.push_back( p.second ); }
+				for ( std::size_t from = 0; from < keys.size(); from += BlockSize )
+				{
+					auto to = std::min( keys.size(), from + BlockSize );
+					Block block;
+					block.offset = int( mv_Bytes.size() );
+					_encode( keys.data() + from, keys.data() + to, mv_Bytes );
+					block.bytes = int( mv_Bytes.size() ) - block.offset;
+					block.count = int( to - from );
+					block.first = int( from );
+					mv_Blocks.push_back( block );
+				}
+				mi_Length = int( keys.size() );
+				mv_Bytes.shrink_to_fit();
+			}
+
+			/**
+			 * @brief      Finds the minimum key, the first of the first block.
+			 *
+			 * @return     The minimum key.
+			 */
+			std::string min ( void ) const
+			{
+				if ( mi_Length == 0 ) throw std::out_of_range("Cannot access min element on an empty dictionary.");
+				const char *p = mv_Bytes.data();
+				std::string cur;
+				_next( p, cur );
+				return cur;
+			}
+
+			/**
+			 * @brief      Finds the maximum key, the last of the last block.
+			 *
+			 * @return     The maximum key.
+			 */
+			std::string max ( void ) const
+			{
+				if ( mi_Length == 0 ) throw std::out_of_range("Cannot access max element on an empty dictionary.");
+				std::vector< std::string > keys;
+				_decode( int( mv_Blocks.size() ) - 1, keys );
+				return keys.back();
+			}
+
+			/**
+			 * @brief      Finds the smallest key greater than the one provided
+			 *             by the client, which need not be stored.
+			 *
+			 * @param[in]  _x    Key to find its successor.
+			 * @param      _y    Where the successor's key will be stored.
+			 *
+			 * @return     True if able to find a successor. False otherwise.
+			 */
+			bool successor ( const std::string & _x, std::string & _y ) const
+			{
+				auto b = _find_block( _x );
+				if ( b < 0 ) return false;
+				const char *p = mv_Bytes.data() + mv_Blocks[b].offset;
+				std::string cur;
+				for ( auto i(0); i < mv_Blocks[b].count; ++i )
+				{
+					_next( p, cur );
+					if ( cur.compare( _x ) > 0 ) { _y = cur; return true; }
+				}
+				// The first key of the next block is greater than _x
+				if ( b + 1 == int( mv_Blocks.size() ) ) return false;
+				p = mv_Bytes.data() + mv_Blocks[b + 1].offset;
+				_next( p, cur );
+				_y = cur;
+				return true;
+			}
+
+			/**
+			 * @brief      Finds the greatest key less than the one provided by
+			 *             the client, which need not be stored.
+			 *
+			 * @param[in]  _x    Key to find its predecessor.
+			 * @param      _y    Where the predecessor's key will be stored.
+			 *
+			 * @return     True if able to find a predecessor. False otherwise.
+			 */
+			bool predecessor ( const std::string & _x, std::string & _y ) const
+			{
+				auto b = _find_block( _x );
+				if ( b < 0 ) return false;
+				const char *p = mv_Bytes.data() + mv_Blocks[b].offset;
+				std::string cur;
+				bool found = false;
+				for ( auto i(0); i < mv_Blocks[b].count; ++i )
+				{
+					_next( p, cur );
+					if ( cur.compare( _x ) >= 0 ) break;
+					_y = cur;
+					found = true;
+				}
+				if ( found ) return true;
+				// Every key of the block is not less than _x: the last key of the block before
+				if ( b == 0 ) return false;
+				std::vector< std::string > keys;
+				_decode( b - 1, keys );
+				_y = keys.back();
+				return true;
+			}
+
+			/**
+			 * @brief      Overloading stream operator to print the dictionary's
+			 *             elements in key order.
+			 */
+			inline friend
+			std::ostream &operator<< ( std::ostream& _os, const DFC& _oDict )
+			{
+				_os << "[ ";
+				for ( auto b(0); b < int( _oDict.mv_Blocks.size() ); ++b )
+				{
+					std::vector< std::string > keys;
+					_oDict._decode( b, keys );
+					for ( auto i(0); i < int( keys.size() ); ++i )
+						_os << "{id: " << keys[i] << ", info: " << _oDict.mv_Info[ _oDict.mv_Blocks[b].first + i ] << "} ";
+				}
+				_os << "]";
+				return _os;
+			}
+	};
+}
+
+#endif
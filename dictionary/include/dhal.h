@@ -0,0 +1,201 @@
+/**
+ * @file    dhal.h
+ * @brief   Defining and implementing functions for DHAL.
+ */
+
+#ifndef _DHAL_H_
+#define _DHAL_H_
+
+#include <cstdint>    // std::uint64_t
+#include <functional> // std::less, std::hash
+#include <vector>
+
+#include "dal.h"
+
+namespace ac
+{
+	/**
+	 * @brief      Class for Dictionary with Hashed Array List: a DAL whose
+	 *             elements stay in the same compact, unsorted array, plus an
+	 *             open-addressed hash table (linear probing) from each key to
+	 *             its position. search(), insert() and remove() cost O(1) on
+	 *             average instead of a scan; remove() still fills the gap with
+	 *             the last element and updates its entry in the table.
+	 *             min(), max(), successor() and predecessor() are the ones of
+	 *             DAL.
+	 *
+	 * @tparam     Key            Key of the element.
+	 * @tparam     Data           Value associated to the key.
+	 * @tparam     KeyComparator  Functor to compare keys.
+	 * @tparam     KeyHash        Functor to hash the key. Keys that the
+	 *                            comparator takes as equal must have the
+	 *                            same hash.
+	 * @tparam     Layout         AoS (default) or SoA, see DAL.
+	 */
+	template< typename Key, typename Data, typename KeyComparator = std::less<Key>,
+			  typename KeyHash = std::hash<Key>, typename Layout = AoS >
+	class DHAL : public DAL<Key, Data, KeyComparator, Layout>
+	{
+		protected:
+
+			static const int FREE = -1; // Mark of a free slot in the table
+
+			std::vector< int > mv_Table; // Position in the array of the key in each slot, or FREE
+			int mi_Bits;				 // The table has 2^mi_Bits slots
+
+			/**
+			 * @brief      Home slot of a key: the high bits of its hash times
+			 *             2^64 / golden ratio, which spreads hashes that are
+			 *             close to each other (std::hash of integers is the
+			 *             identity).
+			 */
+			std::size_t _home ( const Key & _x ) const
+			{
+				return std::size_t( ( std::uint64_t( KeyHash()( _x ) ) * 0x9e3779b97f4a7c15ull ) >> ( 64 - mi_Bits ) );
+			}
+
+			/**
+			 * @brief      Auxiliar function that finds the slot of a key, or
+			 *             the free slot where it would go.
+			 */
+			std::size_t _probe ( const Key & _x ) const
+			{
+				KeyComparator comp;
+				auto &data = DAL<Key, Data, KeyComparator, Layout>::ms_Data;
+				auto mask = mv_Table.size() - 1;
+				auto i = _home( _x );
+				while ( mv_Table[i] != FREE )
+				{
+					const Key & k = data.key( mv_Table[i] );
+					if ( not comp( k, _x ) and not comp( _x, k ) ) break;
+					i = ( i + 1 ) & mask;
+				}
+				return i;
+			}
+
+			/**
+			 * @brief      Auxiliar function that frees a slot, moving back
+			 *             the entries after it that would not be found
+			 *             otherwise (no tombstones are left).
+			 */
+			void _erase_slot ( std::size_t _i )
+			{
+				auto &data = DAL<Key, Data, KeyComparator, Layout>::ms_Data;
+				auto mask = mv_Table.size() - 1;
+				auto j = _i;
+				while ( true )
+				{
+					j = ( j + 1 ) & mask;
+					if ( mv_Table[j] == FREE ) break;
+					auto home = _home( data.key( mv_Table[j] ) );
+					// The entry at j may fill the hole at _i if its home is not in (_i, j], cyclically
+					bool stays = ( _i < j ) ? ( _i < home and home <= j ) : ( _i < home or home <= j );
+					if ( not stays )
+					{
+						mv_Table[_i] = mv_Table[j];
+						_i = j;
+					}
+				}
+				mv_Table[_i] = FREE;
+			}
+
+			/**
+			 * @brief      Auxiliar function that rebuilds the table with
+			 *             2^_bits slots.
+			 */
+			void _rehash ( int _bits )
+			{
+				mi_Bits = _bits;
+				mv_Table.assign( std::size_t(1) << _bits, int(FREE) );
+				auto length = DAL<Key, Data, KeyComparator, Layout>::mi_Length;
+				for ( auto pos(0); pos < length; ++pos )
+					mv_Table[ _probe( DAL<Key, Data, KeyComparator, Layout>::ms_Data.key(pos) ) ] = pos;
+			}
+
+		public:
+
+			/**
+			 * @brief      Default constructor, see DAL.
+			 *
+			 * @param[in]  _MaxSz   Initial size of the dictionary.
+			 * @param[in]  _Growth  Factor by which the capacity grows when
+			 *                      full. Not greater than 1.0 means fixed.
+			 */
+			DHAL ( int _MaxSz = DAL<Key, Data, KeyComparator, Layout>::SIZE,
+				   double _Growth = DAL<Key, Data, KeyComparator, Layout>::GROWTH )
+				: DAL< Key, Data, KeyComparator, Layout > ( _MaxSz, _Growth )
+				, mi_Bits(0)
+			{
+				// At most half of the slots are used
+				int bits(4);
+				while ( ( 1 << bits ) < 2 * _MaxSz ) ++bits;
+				_rehash( bits );
+			}
+
+			/**
+			 * @brief      Searches for the match on a key provided by the
+			 *             client, through the hash table.
+			 *
+			 * @param[in]  _x    Key provided by the client to search element.
+			 * @param      _s    Where the information about the found element
+			 *                   will be stored and used by the client.
+			 *
+			 * @return     True if able to find element. False otherwise.
+			 */
+			bool search ( const Key & _x, Data & _s ) const
+			{
+				auto pos = mv_Table[ _probe( _x ) ];
+				if ( pos == FREE ) return false;
+				_s = DAL<Key, Data, KeyComparator, Layout>::ms_Data.info(pos);
+				return true;
+			}
+
+			/**
+			 * @brief      Inserts a new element at the end of the array and
+			 *             its position in the hash table, which doubles when
+			 *             half full.
+			 *
+			 * @param[in]  _newKey   The key of the new element to be inserted.
+			 * @param[in]  _newInfo  The data associated to the key.
+			 *
+			 * @return     True if able to insert, false otherwise.
+			 */
+			bool insert ( const Key & _newKey, const Data & _newInfo )
+			{
+				auto slot = _probe( _newKey );
+				if ( mv_Table[slot] != FREE ) return false;
+				if ( not DAL<Key, Data, KeyComparator, Layout>::_append( _newKey, _newInfo ) ) return false;
+
+				auto length = DAL<Key, Data, KeyComparator, Layout>::mi_Length;
+				if ( 2 * std::size_t( length ) > mv_Table.size() ) _rehash( mi_Bits + 1 );
+				else mv_Table[slot] = length - 1;
+				return true;
+			}
+
+			/**
+			 * @brief      Removes an element by its key: frees its slot,
+			 *             moves the last element to the gap and points its
+			 *             slot to the new position.
+			 *
+			 * @param[in]  _x    Key provided by the client to remove element.
+			 * @param      _s    Where the value of the element to be deleted
+			 *                   will be stored and used by the client.
+			 *
+			 * @return     True if able to remove element, false otherwise.
+			 */
+			bool remove ( const Key & _x, Data & _s )
+			{
+				auto slot = _probe( _x );
+				auto pos = mv_Table[slot];
+				if ( pos == FREE ) return false;
+
+				auto last = DAL<Key, Data, KeyComparator, Layout>::mi_Length - 1;
+				_erase_slot( slot );
+				if ( pos != last ) mv_Table[ _probe( DAL<Key, Data, KeyComparator, Layout>::ms_Data.key(last) ) ] = pos;
+				DAL<Key, Data, KeyComparator, Layout>::_remove_at( pos, _s );
+				return true;
+			}
+	};
+}
+
+#endif
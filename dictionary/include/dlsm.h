@@ -0,0 +1,510 @@
+/**
+ * @file    dlsm.h
+ * @brief   Defining and implementing functions for DLSM.
+ */
+
+#ifndef _DLSM_H_
+#define _DLSM_H_
+
+#include <algorithm>  // std::sort
+#include <functional> // std::less, std::hash
+#include <memory>     // std::unique_ptr
+#include <queue>      // std::priority_queue
+#include <stdexcept>  // std::out_of_range
+#include <iostream>
+#include <utility>    // std::pair
+#include <vector>
+
+#include "bloom.h"
+#include "dal.h"
+#include "dsal.h"
+
+namespace ac
+{
+	/**
+	 * @brief      Class for Dictionary with Log-Structured Merge. Insertions
+	 *             and removals go to a small unsorted memtable (a DAL); when
+	 *             it is full, it becomes an immutable sorted run (a DSAL).
+	 *             Runs are kept in levels: when a level holds Fanout runs,
+	 *             they are merged (k-way) into a single run of the next
+	 *             level. Searches look at the memtable and then at the runs,
+	 *             newest first, skipping the runs whose Bloom filter rules
+	 *             the key out. Removals write a tombstone, dropped once it
+	 *             reaches the oldest data.
+	 *
+	 * @tparam     Key            Key of the element.
+	 * @tparam     Data           Value associated to the key.
+	 * @tparam     KeyComparator  Functor to compare keys.
+	 * @tparam     KeyHash        Functor to hash the key, for the Bloom
+	 *                            filters.
+	 */
+	template< typename Key, typename Data, typename KeyComparator = std::less<Key>, typename KeyHash = std::hash<Key> >
+	class DLSM
+	{
+		protected:
+
+			/**
+			 * @brief      Data of a key, or a tombstone if the key was removed.
+			 */
+			struct Entry
+			{
+				Data info;
+				bool dead;
+			};
+
+			using Pair = std::pair< Key, Entry >;
+
+			/**
+			 * @brief      Memtable: a DAL with fixed capacity whose entries may
+			 *             be read and changed in place. Keys are stored apart
+			 *             from the entries, so the scan only reads keys.
+			 */
+			class MemTable : public DAL< Key, Entry, KeyComparator, SoA >
+			{
+				public:
+					explicit MemTable ( int _MaxSz ) : DAL< Key, Entry, KeyComparator, SoA >( _MaxSz, 1.0 ) { /* empty */ }
+					int find ( const Key & _x ) const { return DAL< Key, Entry, KeyComparator, SoA >::_search( _x ); }
+					void append ( const Key & _x, const Entry & _e ) { this->_append( _x, _e ); } // For a key find() missed
+					const Key & key ( int _i ) const { return this->ms_Data.key(_i); }
+					Entry & entry ( int _i ) { return this->ms_Data.info(_i); }
+					const Entry & entry ( int _i ) const { return this->ms_Data.info(_i); }
+					bool full ( void ) const { return this->size() == this->capacity(); }
+					void clear ( void ) { this->mi_Length = 0; this->mi_MinPos = this->mi_MaxPos = -1; }
+			};
+
+			/**
+			 * @brief      Immutable sorted run with its Bloom filter.
+			 */
+			struct Run
+			{
+				DSAL< Key, Entry, KeyComparator, SoA > dict;
+				Bloom< Key, KeyHash > bloom;
+
+				explicit Run ( const std::vector< Pair > & _batch )
+					: dict( int( _batch.size() ), 1.0 )
+					, bloom( int( _batch.size() ) )
+				{
+					dict.bulk_load( _batch.begin(), _batch.end() );
+					for ( auto & p : _batch ) bloom.add( p.first );
+				}
+			};
+
+			using Level = std::vector< std::unique_ptr< Run > >; // Runs of a level, oldest first
+
+			int mi_Length;                // Number of elements stored
+			int mi_Fanout;                // Runs a level holds before being merged
+			MemTable ms_Mem;              // Most recent insertions and removals
+			std::vector< Level > mv_Levels; // Levels of runs, newest level first
+
+			/**
+			 * @brief      Auxiliar search in the runs, newest first.
+			 *
+			 * @param[in]  _x    Key to be searched.
+			 * @param      _e    Where the newest entry of the key is stored.
+			 *
+			 * @return     True if some run has the key, even as a tombstone.
+			 */
+			bool _find_runs ( const Key & _x, Entry & _e ) const
+			{
+				for ( auto & level : mv_Levels )
+					for ( auto r = level.rbegin(); r != level.rend(); ++r )
+						if ( (*r)->bloom.may_contain( _x ) and (*r)->dict.search( _x, _e ) ) return true;
+				return false;
+			}
+
+			/**
+			 * @brief      Auxiliar search in the memtable and then in the runs.
+			 *
+			 * @return     True if the key was found, even as a tombstone.
+			 */
+			bool _find ( const Key & _x, Entry & _e ) const
+			{
+				auto pos = ms_Mem.find( _x );
+				if ( pos != -1 ) { _e = ms_Mem.entry( pos ); return true; }
+				return _find_runs( _x, _e );
+			}
+
+			/**
+			 * @brief      Auxiliar function that finds the nearest key after
+			 *             (or before) _x among the memtable and the runs, live
+			 *             or not.
+			 *
+			 * @param[in]  _x      Key to start from, or nullptr to find the
+			 *                     first (or last) key.
+			 * @param[in]  _after  Whether to look after or before _x.
+			 * @param      _y      Where the key found is stored.
+			 *
+			 * @return     True if there is such a key. False otherwise.
+			 */
+			bool _neighbour ( const Key *_x, bool _after, Key & _y ) const
+			{
+				KeyComparator comp;
+				auto before = [&comp, _after]( const Key & a, const Key & b ) { return _after ? comp( a, b ) : comp( b, a ); };
+				bool found = false;
+				auto consider = [&]( const Key & k )
+				{
+					if ( not found or before( k, _y ) ) { _y = k; found = true; }
+				};
+
+				for ( auto i(0); i < ms_Mem.size(); ++i )
+					if ( _x == nullptr or before( *_x, ms_Mem.key(i) ) ) consider( ms_Mem.key(i) );
+
+				Key k;
+				for ( auto & level : mv_Levels )
+					for ( auto & run : level )
+					{
+						if ( _x == nullptr ) consider( _after ? run->dict.min() : run->dict.max() );
+						else if ( _after ? run->dict.successor( *_x, k ) : run->dict.predecessor( *_x, k ) ) consider( k );
+					}
+				return found;
+			}
+
+			/**
+			 * @brief      Auxiliar function that finds the nearest live key
+			 *             after (or before) _x, skipping the removed ones.
+			 */
+			bool _live_neighbour ( const Key *_x, bool _after, Key & _y ) const
+			{
+				Entry e;
+				if ( not _neighbour( _x, _after, _y ) ) return false;
+				while ( _find( _y, e ) and e.dead )
+				{
+					Key from = _y;
+					if ( not _neighbour( &from, _after, _y ) ) return false;
+				}
+				return true;
+			}
+
+			/**
+			 * @brief      Auxiliar function that adds a run to a level, and
+			 *             merges the level into the next one when full.
+			 *             Tombstones are dropped when no older data remains.
+			 *
+			 * @param[in]  _level  Level of the new run.
+			 * @param      _batch  Entries of the run, sorted by key.
+			 */
+			void _add_run ( std::size_t _level, std::vector< Pair > & _batch )
+			{
+				bool oldest = true;
+				for ( auto l = _level; l < mv_Levels.size(); ++l ) oldest = oldest and mv_Levels[l].empty();
+				if ( oldest )
+					_batch.erase( std::remove_if( _batch.begin(), _batch.end(),
+												  []( const Pair & p ) { return p.second.dead; } ), _batch.end() );
+				if ( _batch.empty() ) return;
+
+				if ( mv_Levels.size() <= _level ) mv_Levels.resize( _level + 1 );
+				mv_Levels[_level].emplace_back( new Run( _batch ) );
+				if ( int( mv_Levels[_level].size() ) >= mi_Fanout )
+				{
+					auto merged = _merge( mv_Levels[_level] );
+					mv_Levels[_level].clear();
+					_add_run( _level + 1, merged );
+				}
+			}
+
+			/**
+			 * @brief      Auxiliar k-way merge of runs. For keys found in more
+			 *             than one run, the newest entry is kept.
+			 *
+			 * @param[in]  _runs  Runs to be merged, oldest first.
+			 *
+			 * @return     Entries of every run, sorted by key.
+			 */
+			std::vector< Pair > _merge ( const std::vector< const Run * > & _runs ) const
+			{
+				using Itr = typename DSAL< Key, Entry, KeyComparator, SoA >::const_iterator;
+				struct Cursor { Itr it, end; std::size_t age; };
+				KeyComparator comp;
+				// The heap gives the smallest key first and, among equal keys, the newest run.
+				auto later = [&comp]( const Cursor & a, const Cursor & b )
+				{
+					if ( comp( a.it->id, b.it->id ) ) return false;
+					if ( comp( b.it->id, a.it->id ) ) return true;
+					return a.age < b.age;
+				};
+				std::priority_queue< Cursor, std::vector< Cursor >, decltype( later ) > heap( later );
+
+				std::size_t total(0);
+				for ( std::size_t i(0); i < _runs.size(); ++i )
+				{
+					total += _runs[i]->dict.size();
+					if ( not _runs[i]->dict.empty() ) heap.push( Cursor{ _runs[i]->dict.begin(), _runs[i]->dict.end(), i } );
+				}
+
+				std::vector< Pair > merged;
+				merged.reserve( total );
+				while ( not heap.empty() )
+				{
+					auto c = heap.top();
+					heap.pop();
+					if ( merged.empty() or comp( merged.back().first, c.it->id ) )
+						merged.push_back( Pair( c.it->id, c.it->info ) );
+					if ( ++c.it != c.end ) heap.push( c );
+				}
+				return merged;
+			}
+
+			std::vector< Pair > _merge ( const Level & _level ) const
+			{
+				std::vector< const Run * > runs;
+				for ( auto & r : _level ) runs.push_back( r.get() );
+				return _merge( runs );
+			}
+
+		public:
+
+			/**
+			 * @brief      Default constructor. Creates an empty dictionary.
+			 *
+			 * @param[in]  _MemSz   Capacity of the memtable. Provided none,
+			 *                      default value is 256.
+			 * @param[in]  _Fanout  How many runs a level holds before they are
+			 *                      merged. Provided none, default value is 4.
+			 */
+			DLSM ( int _MemSz = 256, int _Fanout = 4 )
+				: mi_Length(0)
+				, mi_Fanout( _Fanout < 2 ? 2 : _Fanout )
+				, ms_Mem( _MemSz < 1 ? 1 : _MemSz )
+			{ /* empty */ }
+
+			DLSM ( const DLSM & ) = delete;
+			DLSM & operator= ( const DLSM & ) = delete;
+
+			/**
+			 * @brief      Destroys the object.
+			 */
+			virtual ~DLSM () { /* empty */ }
+
+			/**
+			 * @brief      Removes every element of the dictionary.
+			 */
+			void clear ( void )
+			{
+				ms_Mem.clear();
+				mv_Levels.clear();
+				mi_Length = 0;
+			}
+
+			/**
+			 * @brief      Writes the memtable as a run and merges every run
+			 *             into a single one, so searches look at one run only.
+			 */
+			void compact ( void )
+			{
+				flush();
+				std::vector< const Run * > runs;
+				for ( auto l = mv_Levels.rbegin(); l != mv_Levels.rend(); ++l )
+					for ( auto & r : *l ) runs.push_back( r.get() );
+				if ( runs.size() < 2 ) return;
+
+				auto merged = _merge( runs );
+				auto deepest = mv_Levels.size() - 1;
+				mv_Levels.clear();
+				_add_run( deepest, merged );
+			}
+
+			/**
+			 * @brief      Writes the memtable as a new run of the first level.
+			 */
+			void flush ( void )
+			{
+				if ( ms_Mem.empty() ) return;
+				std::vector< Pair > batch;
+				batch.reserve( ms_Mem.size() );
+				for ( auto i(0); i < ms_Mem.size(); ++i ) batch.push_back( Pair( ms_Mem.key(i), ms_Mem.entry(i) ) );
+				KeyComparator comp;
+				std::sort( batch.begin(), batch.end(),
+						   [&comp]( const Pair & a, const Pair & b ) { return comp( a.first, b.first ); } );
+				ms_Mem.clear();
+				_add_run( 0, batch );
+			}
+
+			/**
+			 * @brief      Retrieves how many sorted runs the dictionary has.
+			 *
+			 * @return     Number of runs.
+			 */
+			int runs ( void ) const
+			{
+				int count(0);
+				for ( auto & level : mv_Levels ) count += int( level.size() );
+				return count;
+			}
+
+			/**
+			 * @brief      Retrieves how many elements are stored in the
+			 *             dictionary.
+			 *
+			 * @return     Number of elements.
+			 */
+			int size ( void ) const
+			{
+				return mi_Length;
+			}
+
+			/**
+			 * @brief      Checks if the dictionary is empty or not.
+			 *
+			 * @return     True if no elements are stored in the dictionary.
+			 *             False otherwise.
+			 */
+			bool empty ( void ) const
+			{
+				return mi_Length == 0;
+			}
+
+			/**
+			 * @brief      Removes an element of this dictionary by its key,
+			 *             writing a tombstone over it.
+			 *
+			 * @param[in]  _x    Key provided by the client for the element to
+			 *                   be removed.
+			 * @param      _s    If the key was found, its data will be
+			 *                   retrieved inside _s.
+			 *
+			 * @return     True if able to remove element. False otherwise.
+			 */
+			bool remove ( const Key & _x, Data & _s )
+			{
+				auto pos = ms_Mem.find( _x );
+				if ( pos != -1 )
+				{
+					if ( ms_Mem.entry( pos ).dead ) return false;
+					_s = ms_Mem.entry( pos ).info;
+					ms_Mem.entry( pos ).dead = true;
+				}
+				else
+				{
+					Entry e;
+					if ( not _find_runs( _x, e ) or e.dead ) return false;
+					_s = e.info;
+					ms_Mem.append( _x, Entry{ Data(), true } );
+					if ( ms_Mem.full() ) flush();
+				}
+				mi_Length--;
+				return true;
+			}
+
+			/**
+			 * @brief      Searches for the match on a key provided by the
+			 *             client.
+			 *
+			 * @param[in]  _x    Key provided by the client to search element.
+			 * @param      _s    Where the information about the found element
+			 *                   will be stored.
+			 *
+			 * @return     True if able to find element. False otherwise.
+			 */
+			bool search ( const Key & _x, Data & _s ) const
+			{
+				Entry e;
+				if ( not _find( _x, e ) or e.dead ) return false;
+				_s = e.info;
+				return true;
+			}
+
+			/**
+			 * @brief      Inserts a new element inside the dictionary.
+			 *
+			 * @param[in]  _newKey   The key of the new element to be inserted.
+			 * @param[in]  _newInfo  The data associated to the key.
+			 *
+			 * @return     True if able to insert, false if the key was
+			 *             already stored.
+			 */
+			bool insert ( const Key & _newKey, const Data & _newInfo )
+			{
+				auto pos = ms_Mem.find( _newKey );
+				if ( pos != -1 )
+				{
+					// Only a tombstone may be written over
+					if ( not ms_Mem.entry( pos ).dead ) return false;
+					ms_Mem.entry( pos ) = Entry{ _newInfo, false };
+				}
+				else
+				{
+					Entry e;
+					if ( _find_runs( _newKey, e ) and not e.dead ) return false;
+					ms_Mem.append( _newKey, Entry{ _newInfo, false } );
+					if ( ms_Mem.full() ) flush();
+				}
+				mi_Length++;
+				return true;
+			}
+
+			/**
+			 * @brief      Finds minimum key in this dictionary.
+			 *
+			 * @return     Mininum key.
+			 */
+			Key min ( void ) const
+			{
+				Key y;
+				if ( not _live_neighbour( nullptr, true, y ) )
+					throw std::out_of_range("Cannot access min element on an empty dictionary.");
+				return y;
+			}
+
+			/**
+			 * @brief      Finds maximum key in this dictionary.
+			 *
+			 * @return     Maximum key.
+			 */
+			Key max ( void ) const
+			{
+				Key y;
+				if ( not _live_neighbour( nullptr, false, y ) )
+					throw std::out_of_range("Cannot access max element on an empty dictionary.");
+				return y;
+			}
+
+			/**
+			 * @brief      Finds the smallest key greater than the one provided
+			 *             by the client, which need not be stored.
+			 *
+			 * @param[in]  _x    Key to find its successor.
+			 * @param      _y    Where the successor's key will be stored.
+			 *
+			 * @return     True if able to find a successor. False otherwise.
+			 */
+			bool successor ( const Key & _x, Key & _y ) const
+			{
+				return _live_neighbour( &_x, true, _y );
+			}
+
+			/**
+			 * @brief      Finds the greatest key less than the one provided by
+			 *             the client, which need not be stored.
+			 *
+			 * @param[in]  _x    Key to find its predecessor.
+			 * @param      _y    Where the predecessor's key will be stored.
+			 *
+			 * @return     True if able to find a predecessor. False otherwise.
+			 */
+			bool predecessor ( const Key & _x, Key & _y ) const
+			{
+				return _live_neighbour( &_x, false, _y );
+			}
+
+			/**
+			 * @brief      Overloading stream operator to print the dictionary's
+			 *             elements in key order.
+			 */
+			inline friend
+			std::ostream &operator<< ( std::ostream& _os, const DLSM& _oDict )
+			{
+				_os << "[ ";
+				Key k;
+				Data d;
+				for ( bool more = _oDict._live_neighbour( nullptr, true, k ); more; more = _oDict.successor( k, k ) )
+				{
+					_oDict.search( k, d );
+					_os << "{id: " << k << ", info: " << d << "} ";
+				}
+				_os << "]";
+				return _os;
+			}
+	};
+}
+
+#endif
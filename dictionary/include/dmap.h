@@ -0,0 +1,383 @@
+/**
+ * @file    dmap.h
+ * @brief   Defining and implementing functions for DMAP.
+ */
+
+#ifndef _DMAP_H_
+#define _DMAP_H_
+
+#include <algorithm>   // std::upper_bound
+#include <cstdint>     // std::uint32_t, std::uint64_t
+#include <cstdio>      // std::FILE, std::fopen, std::fwrite, std::rename, std::remove
+#include <cstring>     // std::memcmp, std::memcpy, std::memset
+#include <functional>  // std::less
+#include <iostream>
+#include <limits>      // std::numeric_limits
+#include <stdexcept>   // std::out_of_range
+#include <string>
+#include <type_traits> // std::is_trivially_copyable
+#include <vector>
+
+#include <fcntl.h>     // open
+#include <sys/mman.h>  // mmap, munmap
+#include <sys/stat.h>  // fstat
+#include <unistd.h>    // close
+
+namespace ac
+{
+	/**
+	 * @brief      Class for Dictionary in a Memory-mapped file: a sorted
+	 *             dictionary saved with write() and searched in place,
+	 *             read-only, after open() maps the file. Opening costs no
+	 *             parsing or copying, and processes mapping the same file
+	 *             share its pages in the page cache.
+	 *
+	 *             The file has a header, a sparse index with every
+	 *             STRIDE-th key, and the records (key and data side by
+	 *             side) in key order. A search first bisects the sparse
+	 *             index, which is small and stays in cache, and then the
+	 *             STRIDE records of one block, about a page.
+	 *
+	 *             Keys and data are written byte by byte, so they must be
+	 *             trivially copyable and hold no pointers (no std::string).
+	 *             The file is only readable on machines with the same byte
+	 *             order and type sizes, which open() checks.
+	 *
+	 * @tparam     Key            Key of the element.
+	 * @tparam     Data           Value associated to the key.
+	 * @tparam     KeyComparator  Functor to compare keys.
+	 */
+	template< typename Key, typename Data, typename KeyComparator = std::less<Key> >
+	class DMAP
+	{
+		static_assert( std::is_trivially_copyable< Key >::value and std::is_trivially_copyable< Data >::value,
+					   "DMAP stores keys and data byte by byte: they must be trivially copyable." );
+
+		protected:
+
+			/**
+			 * @brief      Record of the file: a key and its data.
+			 */
+			struct Record
+			{
+				Key id;
+				Data info;
+			};
+
+			/**
+			 * @brief      Header at the start of the file.
+			 */
+			struct Header
+			{
+				char magic[8];			// "ACDMAP1" and a null
+				std::uint32_t order;	// 0x01020304, as written by this machine
+				std::uint32_t keySize;	// sizeof( Key )
+				std::uint32_t dataSize;	// sizeof( Data )
+				std::uint32_t recordSize; // sizeof( Record )
+				std::uint64_t count;	// Number of records
+				std::uint64_t stride;	// Records per block of the sparse index
+				std::uint64_t records;	// Offset of the records from the start of the file
+			};
+
+			static const std::uint32_t ORDER = 0x01020304;
+			static const std::uint64_t ALIGN = 64; // Alignment of the sparse index and the records
+			// Records per block: about a page of them
+			static constexpr std::uint64_t STRIDE = sizeof( Record ) >= 4096 ? 1 : 4096 / sizeof( Record );
+
+			static const char * _magic ( void ) { return "ACDMAP1"; }
+			static std::uint64_t _align ( std::uint64_t _n ) { return ( _n + ALIGN - 1 ) / ALIGN * ALIGN; }
+
+			void *mpt_Map;				// Mapped file, nullptr if closed
+			std::size_t mi_MapSize;		// Bytes mapped
+			const Key *mpt_Index;		// Sparse index: key of the first record of each block
+			const Record *mpt_Records;	// Records, sorted by key
+			int mi_Length;				// Number of records
+			int mi_Blocks;				// Number of keys in the sparse index
+
+			/**
+			 * @brief      Auxiliary search. Finds the position of the first
+			 *             key not less than the one provided: the last block
+			 *             whose first key is not greater than it, then inside
+			 *             the block (or at the start of the next one).
+			 *
+			 * @return     Position in [0, length].
+			 */
+			int _lower_bound ( const Key & _x ) const
+			{
+				KeyComparator comp;
+				auto block = int( std::upper_bound( mpt_Index, mpt_Index + mi_Blocks, _x, comp ) - mpt_Index ) - 1;
+				if ( block < 0 ) return 0;
+				int left = block * int( STRIDE );
+				int right = std::min( left + int( STRIDE ), mi_Length );
+				while ( left < right )
+				{
+					int mid = left + ( right - left ) / 2;
+					if ( comp( mpt_Records[mid].id, _x ) ) left = mid + 1;
+					else right = mid;
+				}
+				return left;
+			}
+
+		public:
+
+			/**
+			 * @brief      Default constructor. Creates a closed dictionary,
+			 *             which behaves as an empty one.
+			 */
+			DMAP ( void )
+				: mpt_Map( nullptr )
+				, mi_MapSize(0)
+				, mpt_Index( nullptr )
+				, mpt_Records( nullptr )
+				, mi_Length(0)
+				, mi_Blocks(0)
+			{ /* empty */ }
+
+			DMAP ( const DMAP & ) = delete;
+			DMAP & operator= ( const DMAP & ) = delete;
+
+			/**
+			 * @brief      Destroys the object, unmapping the file.
+			 */
+			virtual ~DMAP () { close(); }
+
+			/**
+			 * @brief      Saves a sorted dictionary (e.g. a DSAL) as a file
+			 *             that open() can map.
+			 *
+			 * @param[in]  _path  Where the file is written. Replaced at once
+			 *                    if it exists: processes that map the old
+			 *                    file keep reading it.
+			 * @param[in]  _dict  Dictionary whose begin() and end() walk its
+			 *                    pairs, with fields id and info, in key order.
+			 *
+			 * @tparam     Dict   DSAL, with any layout.
+			 *
+			 * @return     True if the file was written. False otherwise.
+			 */
+			template< typename Dict >
+			static bool write ( const std::string & _path, const Dict & _dict )
+			{
+				// Zeroed first, so the padding between key and data goes to the file as zeros
+				std::vector< Record > records( std::size_t( _dict.size() ) );
+				if ( not records.empty() ) std::memset( static_cast< void * >( records.data() ), 0, records.size() * sizeof( Record ) );
+				std::size_t i(0);
+				for ( auto it = _dict.begin(); it != _dict.end(); ++it, ++i )
+				{
+					records[i].id = it->id;
+					records[i].info = it->info;
+				}
+				std::vector< Key > index;
+				for ( i = 0; i < records.size(); i += STRIDE ) index.push_back( records[i].id );
+
+				Header h;
+				std::memset( &h, 0, sizeof( h ) );
+				std::memcpy( h.magic, _magic(), 8 );
+				h.order = ORDER;
+				h.keySize = sizeof( Key );
+				h.dataSize = sizeof( Data );
+				h.recordSize = sizeof( Record );
+				h.count = records.size();
+				h.stride = STRIDE;
+				auto index_at = _align( sizeof( Header ) );
+				h.records = _align( index_at + index.size() * sizeof( Key ) );
+
+				// Written aside and renamed over _path, so processes that map the old file keep it intact
+				auto temp = _path + ".tmp";
+				std::FILE *file = std::fopen( temp.c_str(), "wb" );
+				if ( file == nullptr ) return false;
+				// Zeros that pad the sections to their alignment
+				std::vector< char > pad( std::size_t( ALIGN ), 0 );
+				bool ok = std::fwrite( &h, sizeof( h ), 1, file ) == 1
+					and std::fwrite( pad.data(), 1, index_at - sizeof( h ), file ) == index_at - sizeof( h )
+					and ( index.empty() or std::fwrite( index.data(), sizeof( Key ), index.size(), file ) == index.size() )
+					and std::fwrite( pad.data(), 1, h.records - index_at - index.size() * sizeof( Key ), file )
+						== h.records - index_at - index.size() * sizeof( Key )
+					and ( records.empty() or std::fwrite( records.data(), sizeof( Record ), records.size(), file ) == records.size() );
+				ok = std::fclose( file ) == 0 and ok and std::rename( temp.c_str(), _path.c_str() ) == 0;
+				if ( not ok ) std::remove( temp.c_str() );
+				return ok;
+			}
+
+			/**
+			 * @brief      Maps a file saved by write(), read-only, closing
+			 *             the file mapped before, if any.
+			 *
+			 * @param[in]  _path  The file.
+			 *
+			 * @return     True if mapped. False if the file cannot be read,
+			 *             was not written by write(), was written with
+			 *             other type sizes or byte order or has its sections
+			 *             misaligned for the types; the dictionary is then
+			 *             closed.
+			 */
+			bool open ( const std::string & _path )
+			{
+				close();
+				int fd = ::open( _path.c_str(), O_RDONLY );
+				if ( fd < 0 ) return false;
+				struct stat st;
+				if ( ::fstat( fd, &st ) != 0 or std::uint64_t( st.st_size ) < sizeof( Header ) ) { ::close( fd ); return false; }
+				auto size = std::size_t( st.st_size );
+				void *map = ::mmap( nullptr, size, PROT_READ, MAP_SHARED, fd, 0 );
+				::close( fd ); // The mapping stays valid
+				if ( map == MAP_FAILED ) return false;
+
+				const Header & h = *static_cast< const Header * >( map );
+				auto index_at = _align( sizeof( Header ) );
+				auto blocks = ( h.count + STRIDE - 1 ) / STRIDE;
+				bool valid = std::memcmp( h.magic, _magic(), 8 ) == 0 and h.order == ORDER
+					and h.keySize == sizeof( Key ) and h.dataSize == sizeof( Data )
+					and h.recordSize == sizeof( Record ) and h.stride == STRIDE
+					and h.count <= std::uint64_t( std::numeric_limits< int >::max() )
+					and index_at % alignof( Key ) == 0 and h.records % alignof( Record ) == 0
+					and h.records >= index_at + blocks * sizeof( Key )
+					and h.records <= size and ( size - h.records ) / sizeof( Record ) >= h.count;
+				if ( not valid ) { ::munmap( map, size ); return false; }
+
+				mpt_Map = map;
+				mi_MapSize = size;
+				mi_Length = int( h.count );
+				mi_Blocks = int( blocks );
+				mpt_Index = reinterpret_cast< const Key * >( static_cast< const char * >( map ) + index_at );
+				mpt_Records = reinterpret_cast< const Record * >( static_cast< const char * >( map ) + h.records );
+				return true;
+			}
+
+			/**
+			 * @brief      Unmaps the file, if any.
+			 */
+			void close ( void )
+			{
+				if ( mpt_Map != nullptr ) ::munmap( mpt_Map, mi_MapSize );
+				mpt_Map = nullptr;
+				mi_MapSize = 0;
+				mpt_Index = nullptr;
+				mpt_Records = nullptr;
+				mi_Length = mi_Blocks = 0;
+			}
+
+			/**
+			 * @brief      Checks if a file is mapped.
+			 */
+			bool is_open ( void ) const
+			{
+				return mpt_Map != nullptr;
+			}
+
+			/**
+			 * @brief      Retrieves how many elements are stored in the
+			 *             dictionary.
+			 *
+			 * @return     Number of elements.
+			 */
+			int size ( void ) const
+			{
+				return mi_Length;
+			}
+
+			/**
+			 * @brief      Checks if the dictionary is empty or not.
+			 *
+			 * @return     True if no elements are stored in the dictionary.
+			 *             False otherwise.
+			 */
+			bool empty ( void ) const
+			{
+				return mi_Length == 0;
+			}
+
+			/**
+			 * @brief      Searches for the match on a key provided by the
+			 *             client.
+			 *
+			 * @param[in]  _x    Key provided by the client to search element.
+			 * @param      _s    Where the information about the found element
+			 *                   will be stored and used by the client.
+			 *
+			 * @return     True if able to find element. False otherwise.
+			 */
+			bool search ( const Key & _x, Data & _s ) const
+			{
+				KeyComparator comp;
+				auto pos = _lower_bound( _x );
+				if ( pos == mi_Length or comp( _x, mpt_Records[pos].id ) ) return false;
+				_s = mpt_Records[pos].info;
+				return true;
+			}
+
+			/**
+			 * @brief      Finds the minimum key, in the first record.
+			 *
+			 * @return     The minimum key.
+			 */
+			Key min ( void ) const
+			{
+				if ( mi_Length == 0 ) throw std::out_of_range("Cannot access min element on an empty dictionary.");
+				return mpt_Records[0].id;
+			}
+
+			/**
+			 * @brief      Finds the maximum key, in the last record.
+			 *
+			 * @return     The maximum key.
+			 */
+			Key max ( void ) const
+			{
+				if ( mi_Length == 0 ) throw std::out_of_range("Cannot access max element on an empty dictionary.");
+				return mpt_Records[mi_Length - 1].id;
+			}
+
+			/**
+			 * @brief      Finds the smallest key greater than the one provided
+			 *             by the client, which need not be stored.
+			 *
+			 * @param[in]  _x    Key to find its successor.
+			 * @param      _y    Where the successor's key will be stored.
+			 *
+			 * @return     True if able to find a successor. False otherwise.
+			 */
+			bool successor ( const Key & _x, Key & _y ) const
+			{
+				KeyComparator comp;
+				auto s = _lower_bound( _x );
+				if ( s != mi_Length and not comp( _x, mpt_Records[s].id ) ) ++s;
+				if ( s == mi_Length ) return false;
+				_y = mpt_Records[s].id;
+				return true;
+			}
+
+			/**
+			 * @brief      Finds the greatest key less than the one provided by
+			 *             the client, which need not be stored.
+			 *
+			 * @param[in]  _x    Key to find its predecessor.
+			 * @param      _y    Where the predecessor's key will be stored.
+			 *
+			 * @return     True if able to find a predecessor. False otherwise.
+			 */
+			bool predecessor ( const Key & _x, Key & _y ) const
+			{
+				auto s = _lower_bound( _x );
+				if ( s == 0 ) return false;
+				_y = mpt_Records[s - 1].id;
+				return true;
+			}
+
+			/**
+			 * @brief      Overloading stream operator to print the dictionary's
+			 *             elements in key order.
+			 */
+			inline friend
+			std::ostream &operator<< ( std::ostream& _os, const DMAP& _oMap )
+			{
+				_os << "[ ";
+				for ( auto i(0); i < _oMap.mi_Length; ++i )
+					_os << "{id: " << _oMap.mpt_Records[i].id << ", info: " << _oMap.mpt_Records[i].info << "} ";
+				_os << "]";
+				return _os;
+			}
+	};
+}
+
+#endif
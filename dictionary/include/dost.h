@@ -0,0 +1,437 @@
+/**
+ * @file    dost.h
+ * @brief   Defining and implementing functions for DOST.
+ */
+
+#ifndef _DOST_H_
+#define _DOST_H_
+
+#include <algorithm>  // std::max
+#include <functional> // std::less
+#include <stdexcept>  // std::out_of_range
+#include <iostream>
+
+namespace ac
+{
+	/**
+	 * @brief      Class for Dictionary with Order-Statistic Tree: an AVL tree
+	 *             whose nodes also keep the size of their subtree. Besides
+	 *             the usual O(log n) insert(), remove() and search(), it
+	 *             answers how many keys are less than a given one (rank) and
+	 *             which key has a given rank (select) in O(log n), with any
+	 *             mix of updates in between.
+	 *
+	 * @tparam     Key            Key of the element.
+	 * @tparam     Data           Value associated to the key.
+	 * @tparam     KeyComparator  Functor to compare keys.
+	 */
+	template< typename Key, typename Data, typename KeyComparator = std::less<Key> >
+	class DOST
+	{
+		protected:
+
+			/**
+			 * @brief      Tree node: the pair, its children, the height and
+			 *             the number of nodes of its subtree.
+			 */
+			struct Node
+			{
+				Key id;
+				Data info;
+				Node *left;
+				Node *right;
+				int height;
+				int count;
+
+				Node ( const Key & _id, const Data & _info )
+					: id( _id ), info( _info ), left( nullptr ), right( nullptr ), height(1), count(1)
+				{ /* empty */ }
+			};
+
+			Node *mpt_Root; // Root of the tree, nullptr if empty
+
+			static int _height ( const Node *_n ) { return _n == nullptr ? 0 : _n->height; }
+			static int _count ( const Node *_n ) { return _n == nullptr ? 0 : _n->count; }
+
+			/**
+			 * @brief      Recomputes the height and size of a node from its
+			 *             children.
+			 */
+			static void _update ( Node *_n )
+			{
+				_n->height = 1 + std::max( _height( _n->left ), _height( _n->right ) );
+				_n->count = 1 + _count( _n->left ) + _count( _n->right );
+			}
+
+			static Node * _rotate_right ( Node *_n )
+			{
+				auto l = _n->left;
+				_n->left = l->right;
+				l->right = _n;
+				_update( _n );
+				_update( l );
+				return l;
+			}
+
+			static Node * _rotate_left ( Node *_n )
+			{
+				auto r = _n->right;
+				_n->right = r->left;
+				r->left = _n;
+				_update( _n );
+				_update( r );
+				return r;
+			}
+
+			/**
+			 * @brief      Auxiliar function that restores the AVL balance of
+			 *             a node whose subtrees differ by at most 2 in height.
+			 *
+			 * @return     New root of the subtree.
+			 */
+			static Node * _balance ( Node *_n )
+			{
+				_update( _n );
+				auto diff = _height( _n->left ) - _height( _n->right );
+				if ( diff > 1 )
+				{
+					if ( _height( _n->left->left ) < _height( _n->left->right ) ) _n->left = _rotate_left( _n->left );
+					return _rotate_right( _n );
+				}
+				if ( diff < -1 )
+				{
+					if ( _height( _n->right->right ) < _height( _n->right->left ) ) _n->right = _rotate_right( _n->right );
+					return _rotate_left( _n );
+				}
+				return _n;
+			}
+
+			/**
+			 * @brief      Auxiliar function that inserts a pair in a subtree.
+			 *
+			 * @param      _inserted  Set to false if the key was already
+			 *                        stored.
+			 *
+			 * @return     New root of the subtree.
+			 */
+			Node * _insert ( Node *_n, const Key & _x, const Data & _info, bool & _inserted )
+			{
+				if ( _n == nullptr ) return new Node( _x, _info );
+				KeyComparator comp;
+				if ( comp( _x, _n->id ) ) _n->left = _insert( _n->left, _x, _info, _inserted );
+				else if ( comp( _n->id, _x ) ) _n->right = _insert( _n->right, _x, _info, _inserted );
+				else { _inserted = false; return _n; }
+				return _balance( _n );
+			}
+
+			/**
+			 * @brief      Auxiliar function that unlinks the minimum node of a
+			 *             subtree (not deleting it).
+			 *
+			 * @param      _min  Set to the unlinked node.
+			 *
+			 * @return     New root of the subtree.
+			 */
+			Node * _unlink_min ( Node *_n, Node *& _min )
+			{
+				if ( _n->left == nullptr ) { _min = _n; return _n->right; }
+				_n->left = _unlink_min( _n->left, _min );
+				return _balance( _n );
+			}
+
+			/**
+			 * @brief      Auxiliar function that removes a key from a subtree.
+			 *
+			 * @param      _removed  Set to true if the key was found; its data
+			 *                       is then stored in _s.
+			 *
+			 * @return     New root of the subtree.
+			 */
+			Node * _remove ( Node *_n, const Key & _x, Data & _s, bool & _removed )
+			{
+				if ( _n == nullptr ) return nullptr;
+				KeyComparator comp;
+				if ( comp( _x, _n->id ) ) _n->left = _remove( _n->left, _x, _s, _removed );
+				else if ( comp( _n->id, _x ) ) _n->right = _remove( _n->right, _x, _s, _removed );
+				else
+				{
+					_removed = true;
+					_s = _n->info;
+					auto l = _n->left, r = _n->right;
+					delete _n;
+					if ( r == nullptr ) return l;
+					Node *min;
+					r = _unlink_min( r, min );
+					min->left = l;
+					min->right = r;
+					return _balance( min );
+				}
+				return _balance( _n );
+			}
+
+			/**
+			 * @brief      Auxiliar function that finds the node of a key.
+			 *
+			 * @return     The node, or nullptr if the key is not stored.
+			 */
+			Node * _find ( const Key & _x ) const
+			{
+				KeyComparator comp;
+				auto n = mpt_Root;
+				while ( n != nullptr )
+				{
+					if ( comp( _x, n->id ) ) n = n->left;
+					else if ( comp( n->id, _x ) ) n = n->right;
+					else return n;
+				}
+				return nullptr;
+			}
+
+			static void _destroy ( Node *_n )
+			{
+				if ( _n == nullptr ) return;
+				_destroy( _n->left );
+				_destroy( _n->right );
+				delete _n;
+			}
+
+			static void _print ( std::ostream & _os, const Node *_n )
+			{
+				if ( _n == nullptr ) return;
+				_print( _os, _n->left );
+				_os << "{id: " << _n->id << ", info: " << _n->info << "} ";
+				_print( _os, _n->right );
+			}
+
+		public:
+
+			/**
+			 * @brief      Default constructor. Creates an empty tree.
+			 */
+			DOST ( void ) : mpt_Root( nullptr ) { /* empty */ }
+
+			DOST ( const DOST & ) = delete;
+			DOST & operator= ( const DOST & ) = delete;
+
+			/**
+			 * @brief      Destroys the object.
+			 */
+			virtual ~DOST () { _destroy( mpt_Root ); }
+
+			/**
+			 * @brief      Removes every element of the dictionary.
+			 */
+			void clear ( void )
+			{
+				_destroy( mpt_Root );
+				mpt_Root = nullptr;
+			}
+
+			/**
+			 * @brief      Retrieves how many elements are stored in the
+			 *             dictionary.
+			 *
+			 * @return     Number of elements.
+			 */
+			int size ( void ) const
+			{
+				return _count( mpt_Root );
+			}
+
+			/**
+			 * @brief      Checks if the dictionary is empty or not.
+			 *
+			 * @return     True if no elements are stored in the dictionary.
+			 *             False otherwise.
+			 */
+			bool empty ( void ) const
+			{
+				return mpt_Root == nullptr;
+			}
+
+			/**
+			 * @brief      Searches for the match on a key provided by the
+			 *             client.
+			 *
+			 * @param[in]  _x    Key provided by the client to search element.
+			 * @param      _s    Where the information about the found element
+			 *                   will be stored and used by the client.
+			 *
+			 * @return     True if able to find element. False otherwise.
+			 */
+			bool search ( const Key & _x, Data & _s ) const
+			{
+				auto n = _find( _x );
+				if ( n == nullptr ) return false;
+				_s = n->info;
+				return true;
+			}
+
+			/**
+			 * @brief      Inserts a key and its associate value in this
+			 *             dictionary, rebalancing the path to it.
+			 *
+			 * @param[in]  _newKey   The new key to be added.
+			 * @param[in]  _newInfo  The associated information.
+			 *
+			 * @return     True if able to insert the key-data. False if the
+			 *             key is already stored.
+			 */
+			bool insert ( const Key & _newKey, const Data & _newInfo )
+			{
+				bool inserted = true;
+				mpt_Root = _insert( mpt_Root, _newKey, _newInfo, inserted );
+				return inserted;
+			}
+
+			/**
+			 * @brief      Removes an element of this dictionary by its key.
+			 *
+			 * @param[in]  _x    Key provided by the client for the element to
+			 *                   be removed.
+			 * @param      _s    If the key was found, its data will be
+			 *                   retrieved inside _s.
+			 *
+			 * @return     True if able to remove element. False otherwise.
+			 */
+			bool remove ( const Key & _x, Data & _s )
+			{
+				bool removed = false;
+				mpt_Root = _remove( mpt_Root, _x, _s, removed );
+				return removed;
+			}
+
+			/**
+			 * @brief      Counts the keys less than the one provided by the
+			 *             client, which need not be stored. If it is stored,
+			 *             this is its position in key order, from 0.
+			 *
+			 * @param[in]  _x    Key to be ranked.
+			 *
+			 * @return     Number of stored keys less than _x.
+			 */
+			int rank ( const Key & _x ) const
+			{
+				KeyComparator comp;
+				int r(0);
+				auto n = mpt_Root;
+				while ( n != nullptr )
+				{
+					if ( comp( n->id, _x ) ) { r += _count( n->left ) + 1; n = n->right; }
+					else n = n->left;
+				}
+				return r;
+			}
+
+			/**
+			 * @brief      Finds the key at a given position in key order.
+			 *
+			 * @param[in]  _k    Position, from 0 (the minimum key) to size() - 1
+			 *                   (the maximum key).
+			 * @param      _y    Where the key will be stored.
+			 *
+			 * @return     True if the position exists. False otherwise.
+			 */
+			bool select ( int _k, Key & _y ) const
+			{
+				if ( _k < 0 or _k >= size() ) return false;
+				auto n = mpt_Root;
+				while ( true )
+				{
+					auto left = _count( n->left );
+					if ( _k < left ) n = n->left;
+					else if ( _k > left ) { _k -= left + 1; n = n->right; }
+					else { _y = n->id; return true; }
+				}
+			}
+
+			/**
+			 * @brief      Finds the minimum key, at the leftmost node.
+			 *
+			 * @return     The minimum key.
+			 */
+			Key min () const
+			{
+				if ( mpt_Root == nullptr ) throw std::out_of_range("Cannot find min key on an empty dictionary.");
+				auto n = mpt_Root;
+				while ( n->left != nullptr ) n = n->left;
+				return n->id;
+			}
+
+			/**
+			 * @brief      Finds the maximum key, at the rightmost node.
+			 *
+			 * @return     The maximum key.
+			 */
+			Key max () const
+			{
+				if ( mpt_Root == nullptr ) throw std::out_of_range("Cannot find max key on an empty dictionary.");
+				auto n = mpt_Root;
+				while ( n->right != nullptr ) n = n->right;
+				return n->id;
+			}
+
+			/**
+			 * @brief      Finds the smallest key greater than the one provided
+			 *             by the client, in one descent. The provided key need
+			 *             not be stored.
+			 *
+			 * @param[in]  _x    Key to find its successor.
+			 * @param      _y    Where the successor's key will be stored.
+			 *
+			 * @return     True if able to find a successor. False otherwise.
+			 */
+			bool successor ( const Key & _x, Key & _y ) const
+			{
+				KeyComparator comp;
+				const Node *found = nullptr;
+				for ( auto n = mpt_Root; n != nullptr; )
+				{
+					if ( comp( _x, n->id ) ) { found = n; n = n->left; }
+					else n = n->right;
+				}
+				if ( found == nullptr ) return false;
+				_y = found->id;
+				return true;
+			}
+
+			/**
+			 * @brief      Finds the greatest key less than the one provided by
+			 *             the client, in one descent. The provided key need
+			 *             not be stored.
+			 *
+			 * @param[in]  _x    Key to find its predecessor.
+			 * @param      _y    Where the predecessor's key will be stored.
+			 *
+			 * @return     True if able to find a predecessor. False otherwise.
+			 */
+			bool predecessor ( const Key & _x, Key & _y ) const
+			{
+				KeyComparator comp;
+				const Node *found = nullptr;
+				for ( auto n = mpt_Root; n != nullptr; )
+				{
+					if ( comp( n->id, _x ) ) { found = n; n = n->right; }
+					else n = n->left;
+				}
+				if ( found == nullptr ) return false;
+				_y = found->id;
+				return true;
+			}
+
+			/**
+			 * @brief      Overloading stream operator to print the dictionary's
+			 *             elements in key order.
+			 */
+			inline friend
+			std::ostream &operator<< ( std::ostream& _os, const DOST& _oTree )
+			{
+				_os << "[ ";
+				_print( _os, _oTree.mpt_Root );
+				_os << "]";
+				return _os;
+			}
+	};
+}
+
+#endif
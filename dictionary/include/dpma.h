@@ -0,0 +1,481 @@
+/**
+ * @file    dpma.h
+ * @brief   Defining and implementing functions for DPMA.
+ */
+
+#ifndef _DPMA_H_
+#define _DPMA_H_
+
+#include <algorithm>  // std::move, std::move_backward
+#include <functional> // std::less
+#include <stdexcept>  // std::out_of_range
+#include <iostream>
+#include <iterator>   // std::back_inserter
+#include <vector>
+
+namespace ac
+{
+	/**
+	 * @brief      Class for Dictionary with Packed Memory Array: a sorted
+	 *             array with gaps. The array is split in segments of about
+	 *             log n slots, each holding its keys packed at its start, so
+	 *             an insertion or removal only moves keys inside one segment.
+	 *             When a segment gets full (or empty), the smallest enclosing
+	 *             window of segments whose density is within its bounds is
+	 *             spread evenly; bounds are looser for small windows and
+	 *             tighter for large ones, which gives amortized O(log^2 n)
+	 *             moves per update. Searches stay binary searches: over the
+	 *             first keys of the segments, then inside one segment.
+	 *
+	 * @tparam     Key            Key of the element.
+	 * @tparam     Data           Value associated to the key.
+	 * @tparam     KeyComparator  Functor to compare keys.
+	 */
+	template< typename Key, typename Data, typename KeyComparator = std::less<Key> >
+	class DPMA
+	{
+		protected:
+
+			static const int MIN_CAPACITY=8;           // Capacity of an empty dictionary, a single segment
+			static constexpr double TAU_LEAF=1.0;      // Maximum density of a segment
+			static constexpr double TAU_ROOT=0.75;     // Maximum density of the whole array
+			static constexpr double RHO_LEAF=0.125;    // Minimum density of a segment
+			static constexpr double RHO_ROOT=0.2;      // Minimum density of the whole array, below the 1/4 a rebuild leaves
+
+			int mi_Length;              // Number of elements stored
+			int mi_Capacity;            // Number of slots, a power of 2
+			int mi_SegSize;             // Slots per segment, a power of 2
+			int mi_Segments;            // Number of segments
+			int mi_Height;              // Levels of windows above the segments (log2 of mi_Segments)
+			int mi_Rebuilds;            // Times the whole array was rebuilt by _resize()
+			std::vector< Key > mv_Keys; // Keys, packed at the start of each segment
+			std::vector< Data > mv_Info; // Data, parallel to the keys
+			std::vector< int > mv_Count; // Number of keys in each segment
+
+			const Key & _key ( int _s, int _i ) const { return mv_Keys[ _s * mi_SegSize + _i ]; }
+
+			/**
+			 * @brief      Auxiliar function that finds where a key is or
+			 *             should be: the last segment whose first key is not
+			 *             greater than _x (or the first segment), and the
+			 *             first position in it whose key is not less than _x.
+			 *             Relies on every segment holding a key, which the
+			 *             density bounds guarantee while the dictionary is
+			 *             not empty.
+			 *
+			 * @param[in]  _x    Key to be located.
+			 * @param      _s    Segment found.
+			 * @param      _i    Position in the segment, in [0, count].
+			 */
+			void _locate ( const Key & _x, int & _s, int & _i ) const
+			{
+				KeyComparator comp;
+				int left(0), right( mi_Segments );
+				while ( right - left > 1 )
+				{
+					int mid = left + ( right - left ) / 2;
+					if ( comp( _x, _key( mid, 0 ) ) ) right = mid;
+					else left = mid;
+				}
+				_s = left;
+
+				int first(0), last( mv_Count[_s] );
+				while ( first < last )
+				{
+					int mid = first + ( last - first ) / 2;
+					if ( comp( _key( _s, mid ), _x ) ) first = mid + 1;
+					else last = mid;
+				}
+				_i = first;
+			}
+
+			/**
+			 * @brief      Auxiliar function that tells if a key is at a given
+			 *             position.
+			 */
+			bool _at ( const Key & _x, int _s, int _i ) const
+			{
+				KeyComparator comp;
+				return _i < mv_Count[_s] and not comp( _x, _key( _s, _i ) );
+			}
+
+			/**
+			 * @brief      Density bounds of a window with 2^_h segments.
+			 */
+			double _tau ( int _h ) const { return mi_Height == 0 ? TAU_LEAF : TAU_LEAF - ( TAU_LEAF - TAU_ROOT ) * _h / mi_Height; }
+			double _rho ( int _h ) const { return mi_Height == 0 ? RHO_LEAF : RHO_LEAF + ( RHO_ROOT - RHO_LEAF ) * _h / mi_Height; }
+
+			/**
+			 * @brief      Auxiliar function that spreads the keys of a window
+			 *             of segments evenly among them.
+			 *
+			 * @param[in]  _first  First segment of the window.
+			 * @param[in]  _n      Number of segments of the window.
+			 * @param[in]  _total  Number of keys in the window.
+			 */
+			void _spread ( int _first, int _n, int _total )
+			{
+				std::vector< Key > keys;
+				std::vector< Data > info;
+				keys.reserve( _total );
+				info.reserve( _total );
+				for ( auto s = _first; s < _first + _n; ++s )
+				{
+					auto begin = s * mi_SegSize;
+					std::move( mv_Keys.begin() + begin, mv_Keys.begin() + begin + mv_Count[s], std::back_inserter( keys ) );
+					std::move( mv_Info.begin() + begin, mv_Info.begin() + begin + mv_Count[s], std::back_inserter( info ) );
+				}
+				int next(0);
+				for ( auto s = _first; s < _first + _n; ++s )
+				{
+					mv_Count[s] = _total / _n + ( s - _first < _total % _n ? 1 : 0 );
+					auto begin = s * mi_SegSize;
+					std::move( keys.begin() + next, keys.begin() + next + mv_Count[s], mv_Keys.begin() + begin );
+					std::move( info.begin() + next, info.begin() + next + mv_Count[s], mv_Info.begin() + begin );
+					next += mv_Count[s];
+				}
+			}
+
+			/**
+			 * @brief      Auxiliar function that moves every key to a new
+			 *             array, with half of the slots used.
+			 */
+			void _resize ( void )
+			{
+				std::vector< Key > keys;
+				std::vector< Data > info;
+				keys.reserve( mi_Length );
+				info.reserve( mi_Length );
+				for ( auto s(0); s < mi_Segments; ++s )
+				{
+					auto begin = s * mi_SegSize;
+					std::move( mv_Keys.begin() + begin, mv_Keys.begin() + begin + mv_Count[s], std::back_inserter( keys ) );
+					std::move( mv_Info.begin() + begin, mv_Info.begin() + begin + mv_Count[s], std::back_inserter( info ) );
+				}
+				_allocate( 2 * mi_Length );
+				_fill( keys, info );
+				mi_Rebuilds++;
+			}
+
+			/**
+			 * @brief      Auxiliar function that creates an empty array with
+			 *             room for at least _n keys.
+			 */
+			void _allocate ( int _n )
+			{
+				mi_Capacity = MIN_CAPACITY;
+				while ( mi_Capacity < _n ) mi_Capacity *= 2;
+				int log(0);
+				while ( ( 1 << log ) < mi_Capacity ) ++log;
+				mi_SegSize = MIN_CAPACITY;
+				while ( mi_SegSize < log ) mi_SegSize *= 2;
+				mi_Segments = mi_Capacity / mi_SegSize;
+				mi_Height = 0;
+				while ( ( 1 << mi_Height ) < mi_Segments ) ++mi_Height;
+				mv_Keys.assign( mi_Capacity, Key() );
+				mv_Info.assign( mi_Capacity, Data() );
+				mv_Count.assign( mi_Segments, 0 );
+			}
+
+			/**
+			 * @brief      Auxiliar function that spreads sorted keys evenly
+			 *             over the whole (empty) array.
+			 */
+			void _fill ( std::vector< Key > & _keys, std::vector< Data > & _info )
+			{
+				int total = int( _keys.size() ), next(0);
+				for ( auto s(0); s < mi_Segments; ++s )
+				{
+					mv_Count[s] = total / mi_Segments + ( s < total % mi_Segments ? 1 : 0 );
+					std::move( _keys.begin() + next, _keys.begin() + next + mv_Count[s], mv_Keys.begin() + s * mi_SegSize );
+					std::move( _info.begin() + next, _info.begin() + next + mv_Count[s], mv_Info.begin() + s * mi_SegSize );
+					next += mv_Count[s];
+				}
+			}
+
+			/**
+			 * @brief      Auxiliar function that makes room in a full segment:
+			 *             spreads the smallest enclosing window that stays
+			 *             under its maximum density with one more key, or
+			 *             grows the array if there is none.
+			 *
+			 * @param[in]  _x    Key about to be inserted.
+			 */
+			void _make_room ( const Key & _x )
+			{
+				int s, i;
+				_locate( _x, s, i );
+				for ( auto h(1); h <= mi_Height; ++h )
+				{
+					int first = ( s >> h ) << h, n = 1 << h, total(0);
+					for ( auto w = first; w < first + n; ++w ) total += mv_Count[w];
+					if ( total + 1 > _tau( h ) * n * mi_SegSize ) continue;
+					_spread( first, n, total );
+					_locate( _x, s, i );
+					if ( mv_Count[s] < mi_SegSize ) return;
+				}
+				_resize();
+			}
+
+			/**
+			 * @brief      Auxiliar function that refills a segment left with
+			 *             too few keys: spreads the smallest enclosing window
+			 *             that stays over its minimum density, or shrinks the
+			 *             array if there is none.
+			 *
+			 * @param[in]  _s    Segment that lost a key.
+			 */
+			void _refill ( int _s )
+			{
+				for ( auto h(1); h <= mi_Height; ++h )
+				{
+					int first = ( _s >> h ) << h, n = 1 << h, total(0);
+					for ( auto w = first; w < first + n; ++w ) total += mv_Count[w];
+					if ( total < _rho( h ) * n * mi_SegSize or total < n ) continue;
+					_spread( first, n, total );
+					return;
+				}
+				if ( mi_Segments > 1 ) _resize();
+			}
+
+		public:
+
+			/**
+			 * @brief      Default constructor. Creates an empty dictionary.
+			 */
+			DPMA ( void )
+				: mi_Length(0)
+				, mi_Rebuilds(0)
+			{
+				_allocate( 0 );
+			}
+
+			/**
+			 * @brief      Destroys the object.
+			 */
+			virtual ~DPMA () { /* empty */ }
+
+			/**
+			 * @brief      Removes every element of the dictionary.
+			 */
+			void clear ( void )
+			{
+				mi_Length = 0;
+				_allocate( 0 );
+			}
+
+			/**
+			 * @brief      Retrieves how many elements are stored in the
+			 *             dictionary.
+			 *
+			 * @return     Number of elements.
+			 */
+			int size ( void ) const
+			{
+				return mi_Length;
+			}
+
+			/**
+			 * @brief      Retrieves how many slots the array has, gaps
+			 *             included.
+			 *
+			 * @return     Number of slots.
+			 */
+			int capacity ( void ) const
+			{
+				return mi_Capacity;
+			}
+
+			/**
+			 * @brief      Retrieves how many times the whole array was
+			 *             rebuilt, to grow or to shrink it.
+			 *
+			 * @return     Number of rebuilds.
+			 */
+			int rebuilds ( void ) const
+			{
+				return mi_Rebuilds;
+			}
+
+			/**
+			 * @brief      Checks if the dictionary is empty or not.
+			 *
+			 * @return     True if no elements are stored in the dictionary.
+			 *             False otherwise.
+			 */
+			bool empty ( void ) const
+			{
+				return mi_Length == 0;
+			}
+
+			/**
+			 * @brief      Removes an element of this dictionary by its key.
+			 *
+			 * @param[in]  _x    Key provided by the client for the element to
+			 *                   be removed.
+			 * @param      _s    If the key was found, its data will be
+			 *                   retrieved inside _s.
+			 *
+			 * @return     True if able to remove element. False otherwise.
+			 */
+			bool remove ( const Key & _x, Data & _s )
+			{
+				if ( empty() ) return false;
+				int s, i;
+				_locate( _x, s, i );
+				if ( not _at( _x, s, i ) ) return false;
+
+				auto begin = s * mi_SegSize;
+				_s = mv_Info[ begin + i ];
+				std::move( mv_Keys.begin() + begin + i + 1, mv_Keys.begin() + begin + mv_Count[s], mv_Keys.begin() + begin + i );
+				std::move( mv_Info.begin() + begin + i + 1, mv_Info.begin() + begin + mv_Count[s], mv_Info.begin() + begin + i );
+				mv_Count[s]--;
+				mi_Length--;
+
+				if ( mi_Length == 0 ) clear();
+				else if ( mv_Count[s] < RHO_LEAF * mi_SegSize or mv_Count[s] == 0 ) _refill( s );
+				return true;
+			}
+
+			/**
+			 * @brief      Searches for the match on a key provided by the
+			 *             client.
+			 *
+			 * @param[in]  _x    Key provided by the client to search element.
+			 * @param      _s    Where the information about the found element
+			 *                   will be stored.
+			 *
+			 * @return     True if able to find element. False otherwise.
+			 */
+			bool search ( const Key & _x, Data & _s ) const
+			{
+				if ( empty() ) return false;
+				int s, i;
+				_locate( _x, s, i );
+				if ( not _at( _x, s, i ) ) return false;
+				_s = mv_Info[ s * mi_SegSize + i ];
+				return true;
+			}
+
+			/**
+			 * @brief      Inserts a new element inside the dictionary. Only
+			 *             the keys after it in its segment are moved, unless
+			 *             the segment is full.
+			 *
+			 * @param[in]  _newKey   The key of the new element to be inserted.
+			 * @param[in]  _newInfo  The data associated to the key.
+			 *
+			 * @return     True if able to insert, false if the key was
+			 *             already stored.
+			 */
+			bool insert ( const Key & _newKey, const Data & _newInfo )
+			{
+				int s, i;
+				_locate( _newKey, s, i );
+				if ( _at( _newKey, s, i ) ) return false;
+				if ( mv_Count[s] == mi_SegSize )
+				{
+					_make_room( _newKey );
+					_locate( _newKey, s, i );
+				}
+
+				auto begin = s * mi_SegSize;
+				std::move_backward( mv_Keys.begin() + begin + i, mv_Keys.begin() + begin + mv_Count[s], mv_Keys.begin() + begin + mv_Count[s] + 1 );
+				std::move_backward( mv_Info.begin() + begin + i, mv_Info.begin() + begin + mv_Count[s], mv_Info.begin() + begin + mv_Count[s] + 1 );
+				mv_Keys[ begin + i ] = _newKey;
+				mv_Info[ begin + i ] = _newInfo;
+				mv_Count[s]++;
+				mi_Length++;
+				return true;
+			}
+
+			/**
+			 * @brief      Finds minimum key in this dictionary, the first key
+			 *             of the first segment.
+			 *
+			 * @return     Mininum key.
+			 */
+			Key min ( void ) const
+			{
+				if ( empty() ) throw std::out_of_range("Cannot access min element on an empty dictionary.");
+				return _key( 0, 0 );
+			}
+
+			/**
+			 * @brief      Finds maximum key in this dictionary, the last key
+			 *             of the last segment.
+			 *
+			 * @return     Maximum key.
+			 */
+			Key max ( void ) const
+			{
+				if ( empty() ) throw std::out_of_range("Cannot access max element on an empty dictionary.");
+				return _key( mi_Segments - 1, mv_Count[ mi_Segments - 1 ] - 1 );
+			}
+
+			/**
+			 * @brief      Finds the smallest key greater than the one provided
+			 *             by the client, which need not be stored.
+			 *
+			 * @param[in]  _x    Key to find its successor.
+			 * @param      _y    Where the successor's key will be stored.
+			 *
+			 * @return     True if able to find a successor. False otherwise.
+			 */
+			bool successor ( const Key & _x, Key & _y ) const
+			{
+				if ( empty() ) return false;
+				int s, i;
+				_locate( _x, s, i );
+				if ( _at( _x, s, i ) ) ++i;
+				if ( i == mv_Count[s] )
+				{
+					if ( ++s == mi_Segments ) return false;
+					i = 0;
+				}
+				_y = _key( s, i );
+				return true;
+			}
+
+			/**
+			 * @brief      Finds the greatest key less than the one provided by
+			 *             the client, which need not be stored.
+			 *
+			 * @param[in]  _x    Key to find its predecessor.
+			 * @param      _y    Where the predecessor's key will be stored.
+			 *
+			 * @return     True if able to find a predecessor. False otherwise.
+			 */
+			bool predecessor ( const Key & _x, Key & _y ) const
+			{
+				if ( empty() ) return false;
+				int s, i;
+				_locate( _x, s, i );
+				if ( i == 0 )
+				{
+					if ( s == 0 ) return false;
+					--s;
+					i = mv_Count[s];
+				}
+				_y = _key( s, i - 1 );
+				return true;
+			}
+
+			/**
+			 * @brief      Overloading stream operator to print the dictionary's
+			 *             elements in key order.
+			 */
+			inline friend
+			std::ostream &operator<< ( std::ostream& _os, const DPMA& _oDict )
+			{
+				_os << "[ ";
+				for ( auto s(0); s < _oDict.mi_Segments; ++s )
+					for ( auto i(0); i < _oDict.mv_Count[s]; ++i )
+						_os << "{id: " << _oDict._key( s, i ) << ", info: " << _oDict.mv_Info[ s * _oDict.mi_SegSize + i ] << "} ";
+				_os << "]";
+				return _os;
+			}
+	};
+}
+
+#endif
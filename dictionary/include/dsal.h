@@ -9,7 +9,17 @@
 #ifndef _DSAL_H_
 #define _DSAL_H_
 
+#include <cstddef>     // std::ptrdiff_t
+#include <algorithm>   // std::move, std::move_backward, std::stable_sort, std::unique
+#include <iterator>    // std::distance, std::next, std::random_access_iterator_tag
+#include <utility>     // std::pair
+#include <vector>
+#include <limits>      // std::numeric_limits
+#include <type_traits> // std::integral_constant, std::is_arithmetic
+#include <cmath>       // std::abs, std::sqrt
+
 #include "dal.h"
+#include "search.h"
 
 namespace ac
 {
@@ -19,16 +29,128 @@ namespace ac
 	 * @tparam     Key            Key of the element.
 	 * @tparam     Data           Value associated to key.
 	 * @tparam     KeyComparator  Functor to compare keys.
+	 * @tparam     Layout         AoS (default) or SoA, see DAL.
+	 * @tparam     Search         How the sorted array is searched:
+	 *                            BinarySearch (default),
+	 *                            InterpolationSearch, GallopingSearch or
+	 *                            AdaptiveSearch, see search.h. The
+	 *                            read-optimized mode and the learned index
+	 *                            take over the reads when on. The last two
+	 *                            strategies remember the previous search,
+	 *                            so not even reads may run in several
+	 *                            threads at once.
 	 */
-	template< typename Key, typename Data, typename KeyComparator = std::less<Key> >
-	class DSAL : public DAL<Key, Data, KeyComparator>
+	template< typename Key, typename Data, typename KeyComparator = std::less<Key>, typename Layout = AoS,
+			  typename Search = BinarySearch >
+	class DSAL : public DAL<Key, Data, KeyComparator, Layout>
 	{
 		protected:
 
 			/**
-			 * @brief      Auxiliary search function. Utilizes binary search to
-			 *             find a key and return its position in this
-			 *             dictionary.
+			 * @brief      Auxiliary search. Finds the position of the first
+			 *             key that is not less than the one provided, i.e.
+			 *             where it is stored or where it should be inserted,
+			 *             with the search strategy of the dictionary.
+			 *
+			 * @param[in]  _x    The key to search a position.
+			 *
+			 * @return     Position in [0, length] of the first key not less
+			 *             than _x.
+			 */
+			int _lower_bound ( const Key & _x ) const
+			{
+				return _lower_bound( _x, Search() );
+			}
+
+			int _lower_bound ( const Key & _x, BinarySearch ) const
+			{
+				return binary_lower_bound( DAL<Key, Data, KeyComparator, Layout>::ms_Data, 0,
+										   DAL<Key, Data, KeyComparator, Layout>::mi_Length, _x, KeyComparator() );
+			}
+
+			int _lower_bound ( const Key & _x, InterpolationSearch ) const
+			{
+				return _interpolate( _x, Learnable() );
+			}
+
+			int _lower_bound ( const Key & _x, GallopingSearch ) const
+			{
+				mi_Cursor = galloping_lower_bound( DAL<Key, Data, KeyComparator, Layout>::ms_Data,
+												   DAL<Key, Data, KeyComparator, Layout>::mi_Length,
+												   mi_Cursor, _x, KeyComparator() );
+				return mi_Cursor;
+			}
+
+			int _lower_bound ( const Key & _x, AdaptiveSearch ) const
+			{
+				auto length = DAL<Key, Data, KeyComparator, Layout>::mi_Length;
+				if ( mi_Sampled < 0 or length > 2 * mi_Sampled or 2 * length < mi_Sampled ) _sample( Learnable() );
+
+				int pos;
+				if ( mi_Near >= NEAR ) pos = galloping_lower_bound( DAL<Key, Data, KeyComparator, Layout>::ms_Data,
+																	length, mi_Cursor, _x, KeyComparator() );
+				else if ( mb_Even ) pos = _interpolate( _x, Learnable() );
+				else pos = _lower_bound( _x, BinarySearch() );
+
+				// Galloping d positions costs about 2 log d steps: worth it while d * d < length
+				long d = pos - mi_Cursor;
+				if ( d * d < length ) mi_Near = std::min( mi_Near + 1, 2 * NEAR );
+				else mi_Near = std::max( mi_Near - 4, 0 );
+				mi_Cursor = pos;
+				return pos;
+			}
+
+			/**
+			 * @brief      Interpolation search, if the keys can be
+			 *             interpolated; binary search otherwise.
+			 */
+			int _interpolate ( const Key & _x, std::true_type ) const
+			{
+				return interpolation_lower_bound( DAL<Key, Data, KeyComparator, Layout>::ms_Data,
+												  DAL<Key, Data, KeyComparator, Layout>::mi_Length, _x );
+			}
+
+			int _interpolate ( const Key & _x, std::false_type ) const
+			{
+				return _lower_bound( _x, BinarySearch() );
+			}
+
+			/**
+			 * @brief      Auxiliary function of the adaptive search that
+			 *             samples SAMPLES evenly spaced keys and checks how
+			 *             far they are from the positions a straight line
+			 *             from the minimum to the maximum key predicts. If
+			 *             the keys cannot be interpolated, the answer is no.
+			 */
+			void _sample ( std::true_type ) const
+			{
+				auto &data = DAL<Key, Data, KeyComparator, Layout>::ms_Data;
+				auto length = DAL<Key, Data, KeyComparator, Layout>::mi_Length;
+				mi_Sampled = length;
+				mb_Even = false;
+				if ( length < SAMPLES ) return;
+				double low = double( data.key(0) ), span = double( data.key(length - 1) ) - low;
+				if ( not ( span > 0 ) ) return;
+				double error(0);
+				for ( auto j(0); j < SAMPLES; ++j )
+				{
+					auto i = int( ( long( length - 1 ) * j ) / ( SAMPLES - 1 ) );
+					error += std::abs( ( double( data.key(i) ) - low ) / span * ( length - 1 ) - i );
+				}
+				// Evenly spread keys stray about sqrt(n) positions from the line
+				mb_Even = error / SAMPLES <= 2 * std::sqrt( double( length ) );
+			}
+
+			void _sample ( std::false_type ) const
+			{
+				mi_Sampled = DAL<Key, Data, KeyComparator, Layout>::mi_Length;
+				mb_Even = false;
+			}
+
+			/**
+			 * @brief      Auxiliary search function. Utilizes the search
+			 *             strategy to find a key and return its position in
+			 *             this dictionary.
 			 *
 			 * @param[in]  _x    The key to search an element.
 			 *
@@ -38,39 +160,586 @@ namespace ac
 			int _search ( const Key & _x ) const
 			{
 				KeyComparator comp;
-				auto dict_size = DAL<Key, Data, KeyComparator>::mi_Length;
-				int left(0);
-				int right( dict_size - 1 );
-				int mid(0);
-				
-				while ( left <= right )
+				auto pos = _lower_bound( _x );
+				if ( pos != DAL<Key, Data, KeyComparator, Layout>::mi_Length
+					 and not comp( _x, DAL<Key, Data, KeyComparator, Layout>::ms_Data.key(pos) ) )
+					return pos;
+				return -1;
+			}
+
+			static const int NEAR = 8;		// Close searches in a row that make the adaptive search gallop
+			static const int SAMPLES = 64;	// Keys sampled by the adaptive search
+
+			mutable int mi_Cursor;		// Position found by the previous search (galloping, adaptive)
+			mutable int mi_Near;		// Recent searches close to the previous one (adaptive)
+			mutable int mi_Sampled;		// Length at the last sample of the keys, -1 if none (adaptive)
+			mutable bool mb_Even;		// Whether the sample showed evenly spread keys (adaptive)
+
+			bool mb_ReadOpt;			// Whether reads use the Eytzinger layout
+			mutable bool mb_EytzValid;	// Whether the Eytzinger layout matches the sorted array
+			mutable int mi_EytzCap;		// Capacity of the Eytzinger arrays
+			mutable Key *mpt_Eytz;		// Keys in Eytzinger (BFS) order, starting at index 1
+			mutable int *mpi_EytzPos;	// Position on the sorted array of each key in mpt_Eytz
+
+			/**
+			 * @brief      Segment of the learned index: predicts the position
+			 *             of the keys from key up to the next segment's key.
+			 */
+			struct Segment
+			{
+				double key;		// First key of the segment
+				double slope;	// Positions per unit of key
+				int pos;		// Position of the first key
+			};
+
+			// Keys the learned index and the interpolation search can model: numbers, in their natural order
+			using Learnable = std::integral_constant< bool,
+				std::is_arithmetic< Key >::value and std::is_same< KeyComparator, std::less< Key > >::value >;
+
+			bool mb_Learned;						// Whether reads use the learned index
+			mutable bool mb_LearnedValid;			// Whether the segments match the sorted array
+			int mi_Epsilon;							// Maximum error of the predicted positions
+			mutable std::vector< Segment > mv_Segments; // Segments, by first key
+
+			/**
+			 * @brief      Auxiliary function that marks the read structures as
+			 *             stale after a mutation.
+			 */
+			void _invalidate ( void )
+			{
+				mb_EytzValid = false;
+				mb_LearnedValid = false;
+			}
+
+			/**
+			 * @brief      Rebuilds the learned index, if a mutation made it
+			 *             stale since the last read. Each segment grows while
+			 *             some line through its first key stays within
+			 *             mi_Epsilon positions of every key (shrinking cone),
+			 *             so a single pass is enough.
+			 */
+			void _learned_build ( void ) const
+			{
+				if ( mb_LearnedValid ) return;
+				auto &data = DAL<Key, Data, KeyComparator, Layout>::ms_Data;
+				auto length = DAL<Key, Data, KeyComparator, Layout>::mi_Length;
+				mv_Segments.clear();
+				for ( int i(0), j(0); i < length; i = j )
+				{
+					double k0 = static_cast< double >( data.key(i) );
+					double lo = -std::numeric_limits< double >::infinity();
+					double hi = std::numeric_limits< double >::infinity();
+					for ( j = i + 1; j < length; ++j )
+					{
+						double dx = static_cast< double >( data.key(j) ) - k0;
+						if ( dx <= 0 ) break; // Keys too close for a double
+						double l = ( j - i - mi_Epsilon ) / dx;
+						double h = ( j - i + mi_Epsilon ) / dx;
+						if ( l > hi or h < lo ) break;
+						lo = std::max( lo, l );
+						hi = std::min( hi, h );
+					}
+					mv_Segments.push_back( Segment{ k0, j == i + 1 ? 0.0 : ( lo + hi ) / 2, i } );
+				}
+				mb_LearnedValid = true;
+			}
+
+			/**
+			 * @brief      Lower bound with the learned index: the segment of
+			 *             the key predicts its position, and a binary search
+			 *             over the 2 * mi_Epsilon positions around it finishes
+			 *             the job.
+			 *
+			 * @param[in]  _x    The key to search a position.
+			 *
+			 * @return     Position in [0, length] of the first key not less
+			 *             than _x.
+			 */
+			int _learned_lower_bound ( const Key & _x, std::true_type ) const
+			{
+				_learned_build();
+				auto &data = DAL<Key, Data, KeyComparator, Layout>::ms_Data;
+				auto length = DAL<Key, Data, KeyComparator, Layout>::mi_Length;
+				KeyComparator comp;
+				double x = static_cast< double >( _x );
+
+				auto seg = std::upper_bound( mv_Segments.begin(), mv_Segments.end(), x,
+											 []( double k, const Segment & s ) { return k < s.key; } );
+				if ( seg == mv_Segments.begin() ) return 0;
+				--seg;
+				int next = ( seg + 1 == mv_Segments.end() ) ? length : ( seg + 1 )->pos;
+				double predicted = seg->pos + seg->slope * ( x - seg->key );
+				predicted = std::max( double( seg->pos ), std::min( double( next ), predicted ) );
+
+				int left = std::max( 0, int( predicted ) - mi_Epsilon - 1 );
+				int right = std::min( length, int( predicted ) + mi_Epsilon + 2 );
+				int first = left, last = right;
+				while ( first < last )
+				{
+					int mid = first + ( last - first ) / 2;
+					if ( comp( data.key(mid), _x ) ) first = mid + 1;
+					else last = mid;
+				}
+				// The window is exact for the stored keys; rounding may still miss by a little on huge keys
+				if ( ( first == left and left > 0 and not comp( data.key(left - 1), _x ) )
+					 or ( first == right and right < length and comp( data.key(right), _x ) ) )
+					return _lower_bound( _x );
+				return first;
+			}
+
+			int _learned_lower_bound ( const Key & _x, std::false_type ) const
+			{
+				return _lower_bound( _x );
+			}
+
+			/**
+			 * @brief      Auxiliary function that builds the learned index,
+			 *             for the keys it can model.
+			 */
+			void _learned_prepare ( std::true_type ) const
+			{
+				_learned_build();
+			}
+
+			void _learned_prepare ( std::false_type ) const
+			{ /* empty */ }
+
+			/**
+			 * @brief      Auxiliary function that fills the Eytzinger layout
+			 *             with an in-order walk over the implicit tree.
+			 *
+			 * @param[in]  _i    Next position of the sorted array to be used.
+			 * @param[in]  _k    Node of the implicit tree being filled.
+			 *
+			 * @return     Next position of the sorted array to be used.
+			 */
+			int _eytz_fill ( int _i, int _k ) const
+			{
+				if ( _k <= DAL<Key, Data, KeyComparator, Layout>::mi_Length )
+				{
+					_i = _eytz_fill( _i, 2 * _k );
+					mpt_Eytz[_k] = DAL<Key, Data, KeyComparator, Layout>::ms_Data.key(_i);
+					mpi_EytzPos[_k] = _i++;
+					_i = _eytz_fill( _i, 2 * _k + 1 );
+				}
+				return _i;
+			}
+
+			/**
+			 * @brief      Rebuilds the Eytzinger layout, if a mutation made it
+			 *             stale since the last read.
+			 */
+			void _eytz_build ( void ) const
+			{
+				if ( mb_EytzValid ) return;
+				auto length = DAL<Key, Data, KeyComparator, Layout>::mi_Length;
+				if ( mi_EytzCap < length + 1 )
+				{
+					delete [] mpt_Eytz;
+					delete [] mpi_EytzPos;
+					mi_EytzCap = DAL<Key, Data, KeyComparator, Layout>::mi_Capacity + 1;
+					mpt_Eytz = new Key[mi_EytzCap];
+					mpi_EytzPos = new int[mi_EytzCap];
+				}
+				_eytz_fill( 0, 1 );
+				mpi_EytzPos[0] = length; // Node 0 stands for "no key is greater or equal"
+				mb_EytzValid = true;
+			}
+
+			/**
+			 * @brief      Lower bound over the Eytzinger layout. The descent is
+			 *             branchless and prefetches the grandchildren of each
+			 *             node k, the four nodes 4k..4k+3 two levels below,
+			 *             which lie contiguously.
+			 *
+			 * @param[in]  _x    The key to search a position.
+			 *
+			 * @return     Position in [0, length] of the first key not less
+			 *             than _x on the sorted array.
+			 */
+			int _eytz_lower_bound ( const Key & _x ) const
+			{
+				_eytz_build();
+				KeyComparator comp;
+				auto length = DAL<Key, Data, KeyComparator, Layout>::mi_Length;
+				int k(1);
+				while ( k <= length )
+				{
+#if defined(__GNUC__)
+					if ( k <= length / 4 ) __builtin_prefetch( mpt_Eytz + 4 * k );
+#endif
+					k = 2 * k + comp( mpt_Eytz[k], _x );
+				}
+				// Undoes the right turns taken after the last left turn
+#if defined(__GNUC__)
+				k >>= __builtin_ffs( ~k );
+#else
+				while ( k & 1 ) k >>= 1;
+				k >>= 1;
+#endif
+				return mpi_EytzPos[k];
+			}
+
+			/**
+			 * @brief      Lower bound used by the read operations, with the
+			 *             learned index, over the Eytzinger layout or over the
+			 *             sorted array, depending on the read mode.
+			 *
+			 * @param[in]  _x    The key to search a position.
+			 *
+			 * @return     Position in [0, length] of the first key not less
+			 *             than _x.
+			 */
+			int _read_lower_bound ( const Key & _x ) const
+			{
+				if ( mb_Learned ) return _learned_lower_bound( _x, Learnable() );
+				return mb_ReadOpt ? _eytz_lower_bound( _x ) : _lower_bound( _x );
+			}
+
+			/**
+			 * @brief      Auxiliary search used by the read operations. Uses
+			 *             the learned index or the Eytzinger layout when their
+			 *             modes are on, and the binary search otherwise.
+			 *
+			 * @param[in]  _x    The key to search an element.
+			 *
+			 * @return     The position of the found element (if able to find)
+			 *             or -1 in case search fails.
+			 */
+			int _read_search ( const Key & _x ) const
+			{
+				if ( not mb_ReadOpt and not mb_Learned ) return _search( _x );
+				KeyComparator comp;
+				auto pos = _read_lower_bound( _x );
+				if ( pos != DAL<Key, Data, KeyComparator, Layout>::mi_Length
+					 and not comp( _x, DAL<Key, Data, KeyComparator, Layout>::ms_Data.key(pos) ) )
+					return pos;
+				return -1;
+			}
+
+			/**
+			 * @brief      Auxiliary function that replaces the content with a
+			 *             batch with strictly increasing keys.
+			 *
+			 * @param[in]  first     Where the batch begins.
+			 * @param[in]  last      Where the batch ends.
+			 *
+			 * @tparam     InputItr  Forward iterator to std::pair<Key, Data>.
+			 *
+			 * @return     False if the batch does not fit on a fixed
+			 *             capacity. True otherwise.
+			 */
+			template< typename InputItr >
+			bool _load_sorted ( InputItr first, InputItr last )
+			{
+				auto &length = DAL<Key, Data, KeyComparator, Layout>::mi_Length;
+				auto &data = DAL<Key, Data, KeyComparator, Layout>::ms_Data;
+
+				auto n = static_cast< int >( std::distance( first, last ) );
+				auto old_length = length;
+				length = 0;
+				if ( not DAL<Key, Data, KeyComparator, Layout>::_ensure_room( n ) ) { length = old_length; return false; }
+
+				for ( ; first != last; ++first, ++length )
+				{
+					data.key( length ) = first -> first;
+					data.info( length ) = first -> second;
+				}
+				_invalidate();
+				mi_Sampled = -1;
+				return true;
+			}
+
+			/**
+			 * @brief      Auxiliary backward merge of a batch with strictly
+			 *             increasing keys into the sorted array.
+			 *
+			 * @param[in]  first     Where the batch begins.
+			 * @param[in]  last      Where the batch ends.
+			 *
+			 * @tparam     InputItr  Forward iterator to std::pair<Key, Data>.
+			 *
+			 * @return     False if the new pairs do not fit on a fixed
+			 *             capacity. True otherwise.
+			 */
+			template< typename InputItr >
+			bool _merge_sorted ( InputItr first, InputItr last )
+			{
+				auto &length = DAL<Key, Data, KeyComparator, Layout>::mi_Length;
+				auto &data = DAL<Key, Data, KeyComparator, Layout>::ms_Data;
+				KeyComparator comp;
+
+				// Forward pass: which keys of the batch are new, so the final size is known
+				std::vector< InputItr > fresh;
+				auto i(0);
+				for ( auto it = first; it != last; ++it )
 				{
-					mid = (left + right) / 2;
-					auto data = DAL<Key, Data, KeyComparator>::mpt_Data[mid].id;
-					if ( not comp(data, _x) and not comp(_x, data)	)
-						return mid;
-					if ( comp(_x, data) ) right = mid - 1;
-					else left = mid + 1;
+					while ( i < length and comp( data.key(i), it -> first ) ) ++i;
+					if ( i == length or comp( it -> first, data.key(i) ) ) fresh.push_back( it );
 				}
+				auto m = static_cast< int >( fresh.size() );
+				if ( m == 0 ) return true;
+				if ( not DAL<Key, Data, KeyComparator, Layout>::_ensure_room( m ) ) return false;
 
-				return -1;	
+				// Backward pass: the largest remaining key goes to the last free slot
+				auto w = length + m - 1;
+				auto r = length - 1;
+				for ( auto j = m - 1; j >= 0; --w )
+				{
+					if ( r >= 0 and comp( fresh[j] -> first, data.key(r) ) )
+						data.move( w, r-- );
+					else
+					{
+						data.key(w) = fresh[j] -> first;
+						data.info(w) = fresh[j] -> second;
+						--j;
+					}
+				}
+				length += m;
+				_invalidate();
+				mi_Sampled = -1;
+				return true;
 			}
 
-		public:			
+		public:
+
+			/**
+			 * @brief      Read-only view of a stored pair, with fields id and
+			 *             info, whatever the layout.
+			 */
+			struct value_type
+			{
+				const Key & id;
+				const Data & info;
+			};
+
+			/**
+			 * @brief      Ordered random access iterator over the stored pairs.
+			 *             It is invalidated by any insertion or removal.
+			 */
+			class const_iterator
+			{
+				public:
+					using iterator_category = std::random_access_iterator_tag;
+					using value_type = typename DSAL::value_type;
+					using difference_type = std::ptrdiff_t;
+					using reference = value_type;
+
+					/**
+					 * @brief      Holds a pair so operator-> can point to it.
+					 */
+					struct pointer
+					{
+						value_type m_pair;
+						const value_type * operator->() const { return &m_pair; }
+					};
+
+					const_iterator( const Store< Key, Data, Layout > * _store = nullptr, int _pos = 0 )
+						: m_store(_store), m_pos(_pos) { /* empty */ }
+
+					reference operator*() const { return value_type{ m_store->key( m_pos ), m_store->info( m_pos ) }; }
+					pointer operator->() const { return pointer{ **this }; }
+					reference operator[]( difference_type _n ) const { return *( *this + _n ); }
+
+					const_iterator & operator++() { ++m_pos; return *this; }
+					const_iterator operator++( int ) { auto temp = *this; ++m_pos; return temp; }
+					const_iterator & operator--() { --m_pos; return *this; }
+					const_iterator operator--( int ) { auto temp = *this; --m_pos; return temp; }
+					const_iterator & operator+=( difference_type _n ) { m_pos += int( _n ); return *this; }
+					const_iterator & operator-=( difference_type _n ) { m_pos -= int( _n ); return *this; }
+					const_iterator operator+( difference_type _n ) const { return const_iterator( m_store, m_pos + int( _n ) ); }
+					const_iterator operator-( difference_type _n ) const { return const_iterator( m_store, m_pos - int( _n ) ); }
+					difference_type operator-( const const_iterator & _rhs ) const { return m_pos - _rhs.m_pos; }
+
+					bool operator==( const const_iterator & _rhs ) const { return m_pos == _rhs.m_pos and m_store == _rhs.m_store; }
+					bool operator!=( const const_iterator & _rhs ) const { return not ( *this == _rhs ); }
+					bool operator<( const const_iterator & _rhs ) const { return m_pos < _rhs.m_pos; }
+					bool operator>( const const_iterator & _rhs ) const { return m_pos > _rhs.m_pos; }
+					bool operator<=( const const_iterator & _rhs ) const { return m_pos <= _rhs.m_pos; }
+					bool operator>=( const const_iterator & _rhs ) const { return m_pos >= _rhs.m_pos; }
+
+				private:
+					const Store< Key, Data, Layout > * m_store; //!< Storage of the dictionary.
+					int m_pos; //!< Position on the sorted array.
+			};
+
+			/**
+			 * @brief      View over the pairs with keys in a closed interval,
+			 *             taken straight from the sorted array (no copies).
+			 *             It is invalidated by any insertion or removal.
+			 */
+			class RangeView
+			{
+				public:
+					RangeView( const_iterator _first, const_iterator _last ) : m_first(_first), m_last(_last) { /* empty */ }
+					const_iterator begin( void ) const { return m_first; }
+					const_iterator end( void ) const { return m_last; }
+					int size( void ) const { return int( m_last - m_first ); }
+					bool empty( void ) const { return m_first == m_last; }
+				private:
+					const_iterator m_first; //!< First pair of the interval.
+					const_iterator m_last;  //!< Past the last pair of the interval.
+			};
 			
 			/**
 			 * @brief      Default constructor.
 			 *
-			 * @param[in]  _MaxSz  Size of the dictionary.
+			 * @param[in]  _MaxSz   Initial size of the dictionary.
+			 * @param[in]  _Growth  Factor by which the capacity grows when
+			 *                      full. Not greater than 1.0 means fixed.
 			 */
-			DSAL( int _MaxSz = DAL<Key, Data, KeyComparator>::SIZE )
-				: DAL< Key, Data, KeyComparator > ( _MaxSz )
+			DSAL( int _MaxSz = DAL<Key, Data, KeyComparator, Layout>::SIZE,
+				  double _Growth = DAL<Key, Data, KeyComparator, Layout>::GROWTH )
+				: DAL< Key, Data, KeyComparator, Layout > ( _MaxSz, _Growth )
+				, mi_Cursor(0)
+				, mi_Near(0)
+				, mi_Sampled(-1)
+				, mb_Even(false)
+				, mb_ReadOpt(false)
+				, mb_EytzValid(false)
+				, mi_EytzCap(0)
+				, mpt_Eytz(nullptr)
+				, mpi_EytzPos(nullptr)
+				, mb_Learned(false)
+				, mb_LearnedValid(false)
+				, mi_Epsilon(16)
 			{ /* empty */ }
 
+			/**
+			 * @brief      Copy constructor. The read modes are kept, but the
+			 *             Eytzinger layout and the learned index are rebuilt
+			 *             on the first read of the copy.
+			 *
+			 * @param[in]  _other  The dictionary to be copied.
+			 */
+			DSAL( const DSAL & _other )
+				: DAL< Key, Data, KeyComparator, Layout > ( _other )
+				, mi_Cursor( _other.mi_Cursor )
+				, mi_Near( _other.mi_Near )
+				, mi_Sampled( _other.mi_Sampled )
+				, mb_Even( _other.mb_Even )
+				, mb_ReadOpt( _other.mb_ReadOpt )
+				, mb_EytzValid(false)
+				, mi_EytzCap(0)
+				, mpt_Eytz(nullptr)
+				, mpi_EytzPos(nullptr)
+				, mb_Learned( _other.mb_Learned )
+				, mb_LearnedValid(false)
+				, mi_Epsilon( _other.mi_Epsilon )
+			{ /* empty */ }
+
+			DSAL & operator= ( const DSAL & ) = delete;
+
 			/**
 			 * @brief      Destroys the object.
 			 */
-			virtual ~DSAL() { /* empty */ }
+			virtual ~DSAL() { delete [] mpt_Eytz; delete [] mpi_EytzPos; }
+
+			/**
+			 * @brief      Turns the read-optimized mode on or off. When on,
+			 *             search(), successor() and predecessor() descend a
+			 *             copy of the keys laid out in Eytzinger (BFS) order,
+			 *             which is rebuilt on the first read after a
+			 *             mutation. Suited to dictionaries that are mostly
+			 *             read. Turns the learned index off. That first read
+			 *             writes the copy, so a dictionary read by several
+			 *             threads at once must call prepare_reads() after
+			 *             its last mutation.
+			 *
+			 * @param[in]  _on   True to turn the mode on.
+			 */
+			void set_read_optimized ( bool _on )
+			{
+				if ( _on ) set_learned_index( false );
+				mb_ReadOpt = _on;
+				if ( not _on )
+				{
+					delete [] mpt_Eytz;
+					delete [] mpi_EytzPos;
+					mpt_Eytz = nullptr;
+					mpi_EytzPos = nullptr;
+					mi_EytzCap = 0;
+				}
+				mb_EytzValid = false;
+			}
+
+			/**
+			 * @brief      Turns the learned index on or off. When on,
+			 *             search(), successor() and predecessor() predict the
+			 *             position of the key with a piecewise linear model of
+			 *             the sorted keys and finish with a binary search over
+			 *             2 * _Epsilon positions. The model is rebuilt on the
+			 *             first read after a mutation. It suits numeric keys
+			 *             that are close to evenly spread; other key types,
+			 *             or comparators other than std::less, use the binary
+			 *             search. Turns the read-optimized mode off. As the
+			 *             first read rebuilds the model, a dictionary read by
+			 *             several threads at once must call prepare_reads()
+			 *             after its last mutation.
+			 *
+			 * @param[in]  _on       True to turn the learned index on.
+			 * @param[in]  _Epsilon  Maximum error of the predictions. Provided
+			 *                       none, default value is 16.
+			 */
+			void set_learned_index ( bool _on, int _Epsilon = 16 )
+			{
+				if ( _on ) set_read_optimized( false );
+				mb_Learned = _on;
+				if ( _on ) mi_Epsilon = _Epsilon < 1 ? 1 : _Epsilon;
+				mb_LearnedValid = false;
+				if ( not _on ) std::vector< Segment >().swap( mv_Segments );
+			}
+
+			/**
+			 * @brief      Checks if the learned index is on.
+			 *
+			 * @return     True if it is, false otherwise.
+			 */
+			bool learned_index ( void ) const
+			{
+				return mb_Learned;
+			}
+
+			/**
+			 * @brief      Checks if the read-optimized mode is on.
+			 *
+			 * @return     True if it is, false otherwise.
+			 */
+			bool read_optimized ( void ) const
+			{
+				return mb_ReadOpt;
+			}
+
+			/**
+			 * @brief      Builds the structures of the read mode that is on,
+			 *             which are otherwise built by the first read after a
+			 *             mutation. After it, and until the next mutation,
+			 *             search(), successor() and predecessor() write
+			 *             nothing and may run on several threads at once.
+			 */
+			void prepare_reads ( void ) const
+			{
+				if ( mb_ReadOpt ) _eytz_build();
+				if ( mb_Learned ) _learned_prepare( Learnable() );
+			}
+
+			/**
+			 * @brief      Searches for the match on a key provided by the
+			 *             client.
+			 *
+			 * @param[in]  _x    Key provided by the client to search element.
+			 * @param      _s    Where the information about the found element
+			 *                   will be stored and used by the client.
+			 *
+			 * @return     True if able to find element. False otherwise.
+			 */
+			bool search ( const Key & _x, Data & _s ) const
+			{
+				auto found_position = _read_search( _x );
+				if ( found_position == -1 ) return false;
+				_s = DAL<Key, Data, KeyComparator, Layout>::ms_Data.info(found_position);
+				return true;
+			}
 
 			/**
 			 * @brief      Removes an element of this dictionary by its key.
@@ -86,10 +755,10 @@ namespace ac
 			bool remove ( const Key & _x, Data & _s )
 			{
 				// Checks if dictionary is empty
-				if ( DAL<Key, Data, KeyComparator>::empty() ) return false;
+				if ( DAL<Key, Data, KeyComparator, Layout>::empty() ) return false;
 				
-				auto &length = DAL<Key, Data, KeyComparator>::mi_Length;
-				auto &data = DAL<Key, Data, KeyComparator>::mpt_Data;
+				auto &length = DAL<Key, Data, KeyComparator, Layout>::mi_Length;
+				auto &data = DAL<Key, Data, KeyComparator, Layout>::ms_Data;
 
 				// Searches for key provided by the client
 				auto find = _search( _x );
@@ -98,17 +767,14 @@ namespace ac
 				if ( find == -1 ) return false;
 
 				// Updates _s with the found element
-				_s = data[find].info;
+				_s = data.info(find);
 
 				// Checks if element is the dictionary's back
-				if ( find == length - 1 ) { length -= 1;  return true; }				
+				_invalidate();
+				if ( find == length - 1 ) { length -= 1;  return true; }
 
 				// Otherwise, we need to delete and fill the gap
-				for ( auto i(find); i < length - 1; ++i )
-				{
-					data[i].id = data[i + 1].id;
-					data[i].info = data[i + 1].info;
-				}
+				data.shift( find + 1, length, -1 );
 
 				length -= 1;
 				return true;
@@ -125,66 +791,105 @@ namespace ac
 			 */
 			bool insert ( const Key & _newKey, const Data & _newInfo )
 			{
-				auto capacity = DAL<Key, Data, KeyComparator>::mi_Capacity;
-				auto &length = DAL<Key, Data, KeyComparator>::mi_Length;
-				auto &data = DAL<Key, Data, KeyComparator>::mpt_Data;
+				auto &length = DAL<Key, Data, KeyComparator, Layout>::mi_Length;
+				auto &data = DAL<Key, Data, KeyComparator, Layout>::ms_Data;
+				KeyComparator comp;
 
-				// Checks if the dictionary is empty and this is the first insertion
-				if ( length == 0 )
-				{
-					data[0].id = _newKey;
-					data[0].info = _newInfo;
-					length += 1;
-					return true;
-				}
+				// The same binary search finds where the key is or where it should be stored
+				auto store_at = _lower_bound( _newKey );
 
-				// Checks if the dictionary can store new data and the client's input is unique
-				if ( length == capacity or _search(_newKey) != -1) return false;
+				// Checks if the client's input is unique and the dictionary can store new data
+				if ( store_at != length and not comp( _newKey, data.key(store_at) ) ) return false;
+				if ( not DAL<Key, Data, KeyComparator, Layout>::_ensure_room() ) return false;
 
-				// We need to check where the input will be stored. For this, we need to find its immediate predecessor.
+				// Opens a gap for the insertion, moving the tail one position to the right
+				if ( store_at != length ) data.shift( store_at, length, 1 );
+
+				data.key(store_at) = _newKey;
+				data.info(store_at) = _newInfo;
+				length += 1;
+				_invalidate();
+				return true;
+			}
+
+			/**
+			 * @brief      Replaces the content of this dictionary with the
+			 *             pairs of a range, written in a single pass. If the
+			 *             range is not sorted by key, a sorted copy is made
+			 *             first; for repeated keys the first occurrence is
+			 *             kept, as if insert() was called for each pair in
+			 *             order.
+			 *
+			 * @param[in]  first     Where the range begins.
+			 * @param[in]  last      Where the range ends.
+			 *
+			 * @tparam     InputItr  Forward iterator to std::pair<Key, Data>.
+			 *
+			 * @return     True if loaded. False if the pairs do not fit and
+			 *             the capacity is fixed, in which case the dictionary
+			 *             is left untouched.
+			 */
+			template< typename InputItr >
+			bool bulk_load ( InputItr first, InputItr last )
+			{
 				KeyComparator comp;
-				auto store_at = -1; // Where the new key will be inserted
 
-				// Finding _newKey's predecessor (it will be inserted right after it)
-				for(auto i(0); i != length; ++i)
+				bool sorted = true;
+				if ( first != last )
 				{
-					if ( comp( data[i].id, _newKey ) ) store_at = i;						
+					auto prev = first;
+					for ( auto it = std::next( first ); it != last and sorted; ++it, ++prev )
+						if ( not comp( prev -> first, it -> first ) ) sorted = false;
 				}
+				if ( sorted ) return _load_sorted( first, last );
 
-				// Check if found position is at end of dictionary
-				if ( store_at == length - 1 )
-				{
-					data[length].id = _newKey;
-					data[length].info = _newInfo;
-					length += 1;
-					return true;
-				}
-				else if ( store_at == - 1 ) // Means that its a insertion at the beginning of the dictionary
+				using Pair = std::pair< Key, Data >;
+				std::vector< Pair > batch( first, last );
+				auto by_key = [&comp]( const Pair & a, const Pair & b ) { return comp( a.first, b.first ); };
+				auto same_key = [&comp]( const Pair & a, const Pair & b ) { return not comp( a.first, b.first ) and not comp( b.first, a.first ); };
+				std::stable_sort( batch.begin(), batch.end(), by_key );
+				batch.erase( std::unique( batch.begin(), batch.end(), same_key ), batch.end() );
+				return _load_sorted( batch.cbegin(), batch.cend() );
+			}
+
+			/**
+			 * @brief      Inserts a batch of pairs, merging it with the stored
+			 *             ones from the back of the array, so each stored pair
+			 *             moves at most once: O(n + m) instead of one shift per
+			 *             key. Keys already stored (or repeated in the batch)
+			 *             are skipped, as insert() would refuse them. The batch
+			 *             should be sorted by key; if it is not, a sorted copy
+			 *             is made first.
+			 *
+			 * @param[in]  first     Where the batch begins.
+			 * @param[in]  last      Where the batch ends.
+			 *
+			 * @tparam     InputItr  Forward iterator to std::pair<Key, Data>.
+			 *
+			 * @return     True if merged. False if the new pairs do not fit
+			 *             and the capacity is fixed, in which case nothing is
+			 *             inserted.
+			 */
+			template< typename InputItr >
+			bool merge_insert ( InputItr first, InputItr last )
+			{
+				KeyComparator comp;
+				bool sorted = true;
+				if ( first != last )
 				{
-					// Shift data to right to open gap for insertion
-					for ( auto i(length); i > store_at + 1; --i )
-					{
-						data[i].id = data[i-1].id;
-						data[i].info = data[i-1].info;
-					}
-					data[0].id = _newKey;
-					data[0].info = _newInfo;
-					length += 1;
-					return true;
+					auto prev = first;
+					for ( auto it = std::next( first ); it != last and sorted; ++it, ++prev )
+						if ( not comp( prev -> first, it -> first ) ) sorted = false;
 				}
-				else // Means its a regular insertion at the "middle" of the dictionary
-				{
-					for ( auto i(length); i > store_at + 1; --i)
-					{
-						data[i].id = data[i-1].id;
-						data[i].info = data[i-1].info;
-					}
+				if ( sorted ) return _merge_sorted( first, last );
 
-					data[store_at+1].id = _newKey;
-					data[store_at+1].info = _newInfo;
-					length += 1;
-					return true;
-				}
+				using Pair = std::pair< Key, Data >;
+				std::vector< Pair > batch( first, last );
+				auto by_key = [&comp]( const Pair & a, const Pair & b ) { return comp( a.first, b.first ); };
+				auto same_key = [&comp]( const Pair & a, const Pair & b ) { return not comp( a.first, b.first ) and not comp( b.first, a.first ); };
+				std::stable_sort( batch.begin(), batch.end(), by_key );
+				batch.erase( std::unique( batch.begin(), batch.end(), same_key ), batch.end() );
+				return _merge_sorted( batch.cbegin(), batch.cend() );
 			}
 
 			/**
@@ -196,9 +901,9 @@ namespace ac
 			 */
 			Key min( void ) const
 			{
-				if ( DAL<Key, Data, KeyComparator>::mi_Length == 0 )
+				if ( DAL<Key, Data, KeyComparator, Layout>::mi_Length == 0 )
 					throw std::out_of_range("Cannot access min element on an empty dictionary.");
-				return DAL<Key, Data, KeyComparator>::mpt_Data[0].id;
+				return DAL<Key, Data, KeyComparator, Layout>::ms_Data.key(0);
 			}
 
 			/**
@@ -210,15 +915,17 @@ namespace ac
 			 */
 			Key max( void ) const
 			{
-				auto len = DAL<Key, Data, KeyComparator>::mi_Length;
+				auto len = DAL<Key, Data, KeyComparator, Layout>::mi_Length;
 				if ( len == 0 )
 					throw std::out_of_range("Cannot access max element on an empty dictionary.");
-				return DAL<Key, Data, KeyComparator>::mpt_Data[len - 1].id;
+				return DAL<Key, Data, KeyComparator, Layout>::ms_Data.key(len - 1);
 			}
 
 			/**
-			 * @brief      Finds a key that is the immediate successor to
-			 *             another provided by the client.
+			 * @brief      Finds the smallest key greater than the one provided
+			 *             by the client, with a binary search (or the
+			 *             Eytzinger one, in read-optimized mode). The provided
+			 *             key need not be stored.
 			 *
 			 * @param[in]  _x    Key to find its successor.
 			 * @param      _y    Where the successor's key will be stored and
@@ -228,17 +935,22 @@ namespace ac
 			 */
 			bool successor ( const Key & _x, Key & _y ) const
 			{
-				if ( DAL<Key, Data, KeyComparator>::empty() ) return false;
-				// Check if the provided key is in dictionary or is the last element of the dictionary.
-				auto s = _search(_x);
-				if ( s == -1 or s == DAL<Key, Data, KeyComparator>::mi_Length - 1) return false;
-				_y = DAL<Key, Data, KeyComparator>::mpt_Data[s + 1].id;
+				auto &data = DAL<Key, Data, KeyComparator, Layout>::ms_Data;
+				auto length = DAL<Key, Data, KeyComparator, Layout>::mi_Length;
+				KeyComparator comp;
+				auto s = _read_lower_bound(_x);
+				// Skips _x itself, if stored.
+				if ( s != length and not comp( _x, data.key(s) ) ) ++s;
+				if ( s == length ) return false;
+				_y = data.key(s);
 				return true;
 			}
 
 			/**
-			 * @brief      Finds a key that is the immediate predecessor to
-			 *             another provided by the client.
+			 * @brief      Finds the greatest key less than the one provided by
+			 *             the client, with a binary search (or the Eytzinger
+			 *             one, in read-optimized mode). The provided key need
+			 *             not be stored.
 			 *
 			 * @param[in]  _x    Key to find its predecessor.
 			 * @param      _y    where the predecessor's key will be stored and
@@ -248,13 +960,112 @@ namespace ac
 			 */
 			bool predecessor ( const Key & _x, Key & _y ) const
 			{
-				if ( DAL<Key, Data, KeyComparator>::empty() ) return false;
-				// Check if the provided key is in dictionary or is the first element of the dictionary.
-				auto s = _search(_x);
-				if ( s == -1 or s == 0 ) return false;
-				_y = DAL<Key, Data, KeyComparator>::mpt_Data[s - 1].id;
+				auto s = _read_lower_bound(_x);
+				if ( s == 0 ) return false;
+				_y = DAL<Key, Data, KeyComparator, Layout>::ms_Data.key(s - 1);
+				return true;
+			}
+
+			/**
+			 * @brief      Counts the keys less than the one provided by the
+			 *             client, which need not be stored: the position
+			 *             where it is or would be in the sorted array, found
+			 *             in O(log n).
+			 *
+			 * @param[in]  _x    Key to be ranked.
+			 *
+			 * @return     Number of stored keys less than _x.
+			 */
+			int rank ( const Key & _x ) const
+			{
+				return _read_lower_bound( _x );
+			}
+
+			/**
+			 * @brief      Finds the key at a given position in key order,
+			 *             straight from the sorted array in O(1).
+			 *
+			 * @param[in]  _k    Position, from 0 (the minimum key) to size() - 1
+			 *                   (the maximum key).
+			 * @param      _y    Where the key will be stored.
+			 *
+			 * @return     True if the position exists. False otherwise.
+			 */
+			bool select ( int _k, Key & _y ) const
+			{
+				if ( _k < 0 or _k >= DAL<Key, Data, KeyComparator, Layout>::mi_Length ) return false;
+				_y = DAL<Key, Data, KeyComparator, Layout>::ms_Data.key(_k);
 				return true;
 			}
+
+			/**
+			 * @brief      Iterator to the pair with the minimum key. Iterators
+			 *             walk the pairs in key order and are invalidated by
+			 *             any insertion or removal.
+			 *
+			 * @return     Iterator to the first pair.
+			 */
+			const_iterator begin( void ) const
+			{
+				return const_iterator( &( this -> ms_Data ), 0 );
+			}
+
+			/**
+			 * @brief      Iterator past the pair with the maximum key.
+			 *
+			 * @return     Iterator past the last pair.
+			 */
+			const_iterator end( void ) const
+			{
+				return const_iterator( &( this -> ms_Data ), DAL<Key, Data, KeyComparator, Layout>::mi_Length );
+			}
+
+			/**
+			 * @brief      Positions on the first pair whose key is not less
+			 *             than _x. The key does not need to be stored.
+			 *
+			 * @param[in]  _x    Key to position at.
+			 *
+			 * @return     Iterator to the pair, or end() if every key is less
+			 *             than _x.
+			 */
+			const_iterator lower_bound( const Key & _x ) const
+			{
+				return begin() + _read_lower_bound( _x );
+			}
+
+			/**
+			 * @brief      Positions on the first pair whose key is greater
+			 *             than _x. The key does not need to be stored.
+			 *
+			 * @param[in]  _x    Key to position at.
+			 *
+			 * @return     Iterator to the pair, or end() if no key is greater
+			 *             than _x.
+			 */
+			const_iterator upper_bound( const Key & _x ) const
+			{
+				KeyComparator comp;
+				auto it = lower_bound( _x );
+				if ( it != end() and not comp( _x, it->id ) ) ++it;
+				return it;
+			}
+
+			/**
+			 * @brief      Retrieves every pair with key in [_lo, _hi], in key
+			 *             order, with two binary searches and no copies.
+			 *
+			 * @param[in]  _lo   Lower key of the interval (inclusive).
+			 * @param[in]  _hi   Upper key of the interval (inclusive).
+			 *
+			 * @return     View over the pairs. Empty if _hi is less than _lo.
+			 */
+			RangeView range( const Key & _lo, const Key & _hi ) const
+			{
+				KeyComparator comp;
+				if ( comp( _hi, _lo ) ) return RangeView( end(), end() );
+				return RangeView( lower_bound( _lo ), upper_bound( _hi ) );
+			}
 	};
 }
 
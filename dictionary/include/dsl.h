@@ -0,0 +1,608 @@
+/**
+ * @file    dsl.h
+ * @brief   Defining and implementing functions for DSL.
+ */
+
+#ifndef _DSL_H_
+#define _DSL_H_
+
+#include <algorithm>  // std::max
+#include <atomic>
+#include <cstddef>    // std::max_align_t
+#include <cstdint>    // std::uintptr_t
+#include <functional> // std::less
+#include <mutex>      // std::mutex, std::lock_guard
+#include <new>        // placement new
+#include <stdexcept>  // std::out_of_range
+#include <iostream>
+#include <thread>     // std::this_thread::yield
+#include <vector>
+
+namespace ac
+{
+	/**
+	 * @brief      Class for Dictionary with Skip List, safe to use from
+	 *             several threads at once. Searches never lock: they only
+	 *             follow the links. Insertions and removals lock just the
+	 *             nodes right before the one being linked or unlinked (lazy
+	 *             skip list), so operations on distant keys do not wait for
+	 *             each other.
+	 *
+	 *             Nodes come from a pool owned by the dictionary. A removed
+	 *             node is not reused right away, since a concurrent search may
+	 *             still be reading it; collect() recycles the removed nodes
+	 *             and must be called when no other thread is using the
+	 *             dictionary.
+	 *
+	 * @tparam     Key            Key of the element.
+	 * @tparam     Data           Value associated to the key.
+	 * @tparam     KeyComparator  Functor to compare keys.
+	 */
+	template< typename Key, typename Data, typename KeyComparator = std::less<Key> >
+	class DSL
+	{
+		protected:
+
+			static const int MAX_LEVEL=24; // Levels of the list, enough for about 2^24 elements
+
+			/**
+			 * @brief      Lock of a single node. Waiting threads yield, since
+			 *             the lock is held only while a few links are changed.
+			 */
+			class SpinLock
+			{
+				public:
+					SpinLock () { m_flag.clear(); }
+					void lock ( void )
+					{
+						while ( m_flag.test_and_set( std::memory_order_acquire ) ) std::this_thread::yield();
+					}
+					void unlock ( void ) { m_flag.clear( std::memory_order_release ); }
+				private:
+					std::atomic_flag m_flag;
+			};
+
+			/**
+			 * @brief      Node of the list. Its links are stored right after
+			 *             it, in the same block of the pool, one per level.
+			 */
+			struct Node
+			{
+				Key id;
+				Data info;
+				int height;                     // Number of levels the node is linked at
+				std::atomic< bool > marked;     // Whether the node is being removed
+				std::atomic< bool > linked;     // Whether the node is linked at every level
+				SpinLock lock;
+				std::atomic< Node * > *next;    // Links, one per level
+
+				Node ( const Key & _id, const Data & _info, int _height, std::atomic< Node * > *_next )
+					: id(_id), info(_info), height(_height), marked(false), linked(false), next(_next)
+				{
+					for ( auto l(0); l < height; ++l ) new ( next + l ) std::atomic< Node * >( nullptr );
+				}
+			};
+
+			/**
+			 * @brief      Allocates nodes from large chunks and keeps the
+			 *             removed ones, by height, until they are recycled.
+			 */
+			class NodePool
+			{
+				public:
+					NodePool () : mpt_Free( MAX_LEVEL + 1 ), mi_Left(0), mpt_Next(nullptr) { /* empty */ }
+					NodePool ( const NodePool & ) = delete;
+					NodePool & operator= ( const NodePool & ) = delete;
+
+					~NodePool ()
+					{
+						for ( auto c : mpt_Chunks ) ::operator delete( c );
+					}
+
+					/**
+					 * @brief      Creates a node with the given height.
+					 */
+					Node * make ( const Key & _id, const Data & _info, int _height )
+					{
+						char *block;
+						{
+							std::lock_guard< std::mutex > guard( m_Mutex );
+							auto & free = mpt_Free[_height];
+							if ( not free.empty() ) { block = free.back(); free.pop_back(); }
+							else block = _bump( _block_size( _height ) );
+						}
+						auto next = reinterpret_cast< std::atomic< Node * > * >( block + _node_size() );
+						return new ( block ) Node( _id, _info, _height, next );
+					}
+
+					/**
+					 * @brief      Keeps a removed node until it can be recycled.
+					 */
+					void retire ( Node *_n )
+					{
+						std::lock_guard< std::mutex > guard( m_Mutex );
+						mpt_Retired.push_back( _n );
+					}
+
+					/**
+					 * @brief      Destroys a node that no thread can reach and
+					 *             makes its block available again.
+					 */
+					void recycle ( Node *_n )
+					{
+						auto height = _n->height;
+						_n->~Node();
+						mpt_Free[height].push_back( reinterpret_cast< char * >( _n ) );
+					}
+
+					/**
+					 * @brief      Recycles every retired node.
+					 */
+					void collect ( void )
+					{
+						for ( auto n : mpt_Retired ) recycle( n );
+						mpt_Retired.clear();
+					}
+
+				private:
+					static std::size_t _align ( std::size_t _n )
+					{
+						const std::size_t a = alignof( std::max_align_t );
+						return ( _n + a - 1 ) / a * a;
+					}
+					static std::size_t _node_size ( void ) { return _align( sizeof( Node ) ); }
+					static std::size_t _block_size ( int _height )
+					{
+						return _align( _node_size() + _height * sizeof( std::atomic< Node * > ) );
+					}
+
+					char * _bump ( std::size_t _n )
+					{
+						if ( _n > mi_Left )
+						{
+							mi_Left = std::max( std::size_t( CHUNK ), _n );
+							mpt_Next = static_cast< char * >( ::operator new( mi_Left ) );
+							mpt_Chunks.push_back( mpt_Next );
+						}
+						auto block = mpt_Next;
+						mpt_Next += _n;
+						mi_Left -= _n;
+						return block;
+					}
+
+					static const std::size_t CHUNK = 64 * 1024; // Bytes requested at a time
+					std::mutex m_Mutex;
+					std::vector< std::vector< char * > > mpt_Free; // Recycled blocks, by height
+					std::vector< Node * > mpt_Retired;             // Removed nodes not yet recycled
+					std::vector< char * > mpt_Chunks;              // Every chunk requested
+					std::size_t mi_Left;                           // Bytes left in the current chunk
+					char *mpt_Next;                                // Next free byte of the current chunk
+			};
+
+			NodePool ms_Pool;
+			Node *mpt_Head;                  // Sentinel before the first node, linked at every level
+			std::atomic< int > mi_Length;    // Number of elements stored
+
+			/**
+			 * @brief      Auxiliar function that draws the height of a new
+			 *             node: h with probability 1 / 2^h.
+			 */
+			static int _random_height ( void )
+			{
+				static thread_local unsigned long long state = 0x9E3779B97F4A7C15ull
+					^ reinterpret_cast< std::uintptr_t >( &state );
+				// xorshift64
+				state ^= state << 13;
+				state ^= state >> 7;
+				state ^= state << 17;
+				auto bits = static_cast< unsigned >( state ) | ( 1u << ( MAX_LEVEL - 1 ) );
+				return __builtin_ctz( bits ) + 1;
+			}
+
+			/**
+			 * @brief      Auxiliar search. Finds, at each level, the last node
+			 *             with key less than _x and the one after it.
+			 *
+			 * @param[in]  _x      Key to be searched.
+			 * @param      _preds  Last node before _x, at each level.
+			 * @param      _succs  First node not before _x, at each level.
+			 *
+			 * @return     Highest level where a node with key _x was found,
+			 *             or -1 if none.
+			 */
+			int _find ( const Key & _x, Node **_preds, Node **_succs ) const
+			{
+				KeyComparator comp;
+				int found(-1);
+				Node *pred = mpt_Head;
+				for ( auto l = MAX_LEVEL - 1; l >= 0; --l )
+				{
+					Node *curr = pred->next[l].load( std::memory_order_acquire );
+					while ( curr != nullptr and comp( curr->id, _x ) )
+					{
+						pred = curr;
+						curr = pred->next[l].load( std::memory_order_acquire );
+					}
+					if ( found == -1 and curr != nullptr and not comp( _x, curr->id ) ) found = l;
+					_preds[l] = pred;
+					_succs[l] = curr;
+				}
+				return found;
+			}
+
+			/**
+			 * @brief      Auxiliar function that locks the distinct nodes in
+			 *             _preds, from level 0 up to _top - 1, and checks that
+			 *             they are still linked to _succs. When inserting, the
+			 *             nodes in _succs must not be marked either; when
+			 *             removing, they are the marked victim.
+			 *
+			 * @return     Highest level locked.
+			 */
+			static int _lock_preds ( Node **_preds, Node **_succs, int _top, bool _removing, bool & _valid )
+			{
+				int highest(-1);
+				Node *prev = nullptr;
+				_valid = true;
+				for ( auto l(0); _valid and l < _top; ++l )
+				{
+					auto pred = _preds[l];
+					auto succ = _succs[l];
+					if ( pred != prev ) { pred->lock.lock(); highest = l; prev = pred; }
+					_valid = not pred->marked.load( std::memory_order_acquire )
+						and ( _removing or succ == nullptr or not succ->marked.load( std::memory_order_acquire ) )
+						and pred->next[l].load( std::memory_order_acquire ) == succ;
+				}
+				return highest;
+			}
+
+			/**
+			 * @brief      Auxiliar function that unlocks what _lock_preds()
+			 *             locked.
+			 */
+			static void _unlock_preds ( Node **_preds, int _highest )
+			{
+				for ( auto l(0); l <= _highest; ++l )
+					if ( l == 0 or _preds[l] != _preds[l - 1] ) _preds[l]->lock.unlock();
+			}
+
+			/**
+			 * @brief      Auxiliar function that tells if a node is stored:
+			 *             linked at every level and not being removed.
+			 */
+			static bool _alive ( const Node *_n )
+			{
+				return _n->linked.load( std::memory_order_acquire ) and not _n->marked.load( std::memory_order_acquire );
+			}
+
+			/**
+			 * @brief      Auxiliar function that finds the last stored node
+			 *             with key less than _x (or with any key, if _all is
+			 *             true). The upper levels may lead to a node that is
+			 *             being removed; in that case, the search is repeated
+			 *             for the last node before it.
+			 *
+			 * @return     The node, or the head if there is none.
+			 */
+			Node * _last_before ( const Key & _x, bool _all ) const
+			{
+				KeyComparator comp;
+				Key bound( _x );
+				for ( ; ; )
+				{
+					Node *pred = mpt_Head;
+					for ( auto l = MAX_LEVEL - 1; l >= 0; --l )
+					{
+						Node *curr = pred->next[l].load( std::memory_order_acquire );
+						while ( curr != nullptr and ( _all or comp( curr->id, bound ) ) )
+						{
+							if ( l == 0 and not _alive( curr ) ) { curr = curr->next[l].load( std::memory_order_acquire ); continue; }
+							pred = curr;
+							curr = pred->next[l].load( std::memory_order_acquire );
+						}
+					}
+					if ( pred == mpt_Head or _alive( pred ) ) return pred;
+					bound = pred->id;
+					_all = false;
+				}
+			}
+
+			/**
+			 * @brief      Auxiliar function that finds the first stored node
+			 *             with key greater than _x (or with any key, if _all
+			 *             is true).
+			 *
+			 * @return     The node, or nullptr if there is none.
+			 */
+			Node * _first_after ( const Key & _x, bool _all ) const
+			{
+				KeyComparator comp;
+				Node *pred = mpt_Head;
+				Node *curr = nullptr;
+				for ( auto l = MAX_LEVEL - 1; l >= 0; --l )
+				{
+					curr = pred->next[l].load( std::memory_order_acquire );
+					while ( curr != nullptr and not _all and not comp( _x, curr->id ) )
+					{
+						pred = curr;
+						curr = pred->next[l].load( std::memory_order_acquire );
+					}
+				}
+				while ( curr != nullptr and not _alive( curr ) ) curr = curr->next[0].load( std::memory_order_acquire );
+				return curr;
+			}
+
+			/**
+			 * @brief      Auxiliar function that destroys every node.
+			 */
+			void _destroy ( void )
+			{
+				ms_Pool.collect();
+				Node *n = mpt_Head->next[0].load();
+				while ( n != nullptr )
+				{
+					Node *next = n->next[0].load();
+					ms_Pool.recycle( n );
+					n = next;
+				}
+				for ( auto l(0); l < MAX_LEVEL; ++l ) mpt_Head->next[l].store( nullptr );
+				mi_Length = 0;
+			}
+
+		public:
+
+			/**
+			 * @brief      Default constructor. Creates an empty list.
+			 */
+			DSL ( void )
+				: mpt_Head( ms_Pool.make( Key(), Data(), MAX_LEVEL ) )
+				, mi_Length(0)
+			{
+				mpt_Head->linked = true;
+			}
+
+			DSL ( const DSL & ) = delete;
+			DSL & operator= ( const DSL & ) = delete;
+
+			/**
+			 * @brief      Destroys the object.
+			 */
+			virtual ~DSL () { _destroy(); ms_Pool.recycle( mpt_Head ); }
+
+			/**
+			 * @brief      Removes every element of the dictionary. Must not be
+			 *             called while other threads use the dictionary.
+			 */
+			void clear ( void )
+			{
+				_destroy();
+			}
+
+			/**
+			 * @brief      Recycles the nodes of the removed elements. Must not
+			 *             be called while other threads use the dictionary.
+			 */
+			void collect ( void )
+			{
+				ms_Pool.collect();
+			}
+
+			/**
+			 * @brief      Retrieves how many elements are stored in the
+			 *             dictionary.
+			 *
+			 * @return     Number of elements.
+			 */
+			int size ( void ) const
+			{
+				return mi_Length.load();
+			}
+
+			/**
+			 * @brief      Checks if the dictionary is empty or not.
+			 *
+			 * @return     True if no elements are stored in the dictionary.
+			 *             False otherwise.
+			 */
+			bool empty ( void ) const
+			{
+				return size() == 0;
+			}
+
+			/**
+			 * @brief      Removes an element of this dictionary by its key.
+			 *             The node is marked first, so searches stop seeing
+			 *             it, and then unlinked from the top level down.
+			 *
+			 * @param[in]  _x    Key provided by the client for the element to
+			 *                   be removed.
+			 * @param      _s    If the key was found, its data will be
+			 *                   retrieved inside _s.
+			 *
+			 * @return     True if able to remove element. False otherwise.
+			 */
+			bool remove ( const Key & _x, Data & _s )
+			{
+				Node *preds[MAX_LEVEL], *succs[MAX_LEVEL];
+				Node *victim = nullptr;
+				bool is_marked = false;
+				while ( true )
+				{
+					auto found = _find( _x, preds, succs );
+					if ( found != -1 ) victim = succs[found];
+					if ( not is_marked )
+					{
+						// Only a fully linked node, found at its top level, can be removed
+						if ( found == -1 or not _alive( victim ) or victim->height - 1 != found ) return false;
+						victim->lock.lock();
+						if ( victim->marked.load() ) { victim->lock.unlock(); return false; }
+						victim->marked.store( true, std::memory_order_release );
+						is_marked = true;
+					}
+
+					bool valid;
+					for ( auto l(0); l < victim->height; ++l ) succs[l] = victim;
+					auto highest = _lock_preds( preds, succs, victim->height, true, valid );
+					if ( not valid ) { _unlock_preds( preds, highest ); continue; }
+
+					for ( auto l = victim->height - 1; l >= 0; --l )
+						preds[l]->next[l].store( victim->next[l].load( std::memory_order_acquire ), std::memory_order_release );
+					_s = victim->info;
+					victim->lock.unlock();
+					_unlock_preds( preds, highest );
+					ms_Pool.retire( victim );
+					mi_Length--;
+					return true;
+				}
+			}
+
+			/**
+			 * @brief      Searches for the match on a key provided by the
+			 *             client, without locking.
+			 *
+			 * @param[in]  _x    Key provided by the client to search element.
+			 * @param      _s    Where the information about the found element
+			 *                   will be stored.
+			 *
+			 * @return     True if able to find element. False otherwise.
+			 */
+			bool search ( const Key & _x, Data & _s ) const
+			{
+				KeyComparator comp;
+				Node *pred = mpt_Head;
+				for ( auto l = MAX_LEVEL - 1; l >= 0; --l )
+				{
+					Node *curr = pred->next[l].load( std::memory_order_acquire );
+					while ( curr != nullptr and comp( curr->id, _x ) )
+					{
+						pred = curr;
+						curr = pred->next[l].load( std::memory_order_acquire );
+					}
+					if ( curr != nullptr and not comp( _x, curr->id ) )
+					{
+						if ( not _alive( curr ) ) return false;
+						_s = curr->info;
+						return true;
+					}
+				}
+				return false;
+			}
+
+			/**
+			 * @brief      Inserts a new element inside the dictionary. The
+			 *             node is linked from level 0 up, and only counts as
+			 *             stored once linked at every level.
+			 *
+			 * @param[in]  _newKey   The key of the new element to be inserted.
+			 * @param[in]  _newInfo  The data associated to the key.
+			 *
+			 * @return     True if able to insert, false if the key was
+			 *             already stored.
+			 */
+			bool insert ( const Key & _newKey, const Data & _newInfo )
+			{
+				Node *preds[MAX_LEVEL], *succs[MAX_LEVEL];
+				auto top = _random_height();
+				while ( true )
+				{
+					auto found = _find( _newKey, preds, succs );
+					if ( found != -1 )
+					{
+						Node *n = succs[found];
+						// Being removed: try again once it is unlinked
+						if ( n->marked.load( std::memory_order_acquire ) ) { std::this_thread::yield(); continue; }
+						while ( not n->linked.load( std::memory_order_acquire ) ) std::this_thread::yield();
+						return false;
+					}
+
+					bool valid;
+					auto highest = _lock_preds( preds, succs, top, false, valid );
+					if ( not valid ) { _unlock_preds( preds, highest ); continue; }
+
+					Node *n = ms_Pool.make( _newKey, _newInfo, top );
+					for ( auto l(0); l < top; ++l ) n->next[l].store( succs[l], std::memory_order_relaxed );
+					for ( auto l(0); l < top; ++l ) preds[l]->next[l].store( n, std::memory_order_release );
+					n->linked.store( true, std::memory_order_release );
+					_unlock_preds( preds, highest );
+					mi_Length++;
+					return true;
+				}
+			}
+
+			/**
+			 * @brief      Finds minimum key in this dictionary, the first one
+			 *             on level 0.
+			 *
+			 * @return     Mininum key.
+			 */
+			Key min ( void ) const
+			{
+				auto n = _first_after( Key(), true );
+				if ( n == nullptr ) throw std::out_of_range("Cannot access min element on an empty dictionary.");
+				return n->id;
+			}
+
+			/**
+			 * @brief      Finds maximum key in this dictionary, descending
+			 *             from the top level as far right as possible.
+			 *
+			 * @return     Maximum key.
+			 */
+			Key max ( void ) const
+			{
+				auto n = _last_before( Key(), true );
+				if ( n == mpt_Head ) throw std::out_of_range("Cannot access max element on an empty dictionary.");
+				return n->id;
+			}
+
+			/**
+			 * @brief      Finds the smallest key greater than the one provided
+			 *             by the client, which need not be stored.
+			 *
+			 * @param[in]  _x    Key to find its successor.
+			 * @param      _y    Where the successor's key will be stored.
+			 *
+			 * @return     True if able to find a successor. False otherwise.
+			 */
+			bool successor ( const Key & _x, Key & _y ) const
+			{
+				auto n = _first_after( _x, false );
+				if ( n == nullptr ) return false;
+				_y = n->id;
+				return true;
+			}
+
+			/**
+			 * @brief      Finds the greatest key less than the one provided by
+			 *             the client, which need not be stored.
+			 *
+			 * @param[in]  _x    Key to find its predecessor.
+			 * @param      _y    Where the predecessor's key will be stored.
+			 *
+			 * @return     True if able to find a predecessor. False otherwise.
+			 */
+			bool predecessor ( const Key & _x, Key & _y ) const
+			{
+				auto n = _last_before( _x, false );
+				if ( n == mpt_Head ) return false;
+				_y = n->id;
+				return true;
+			}
+
+			/**
+			 * @brief      Overloading stream operator to print the dictionary's
+			 *             elements in key order.
+			 */
+			inline friend
+			std::ostream &operator<< ( std::ostream& _os, const DSL& _oList )
+			{
+				_os << "[ ";
+				for ( auto n = _oList.mpt_Head->next[0].load(); n != nullptr; n = n->next[0].load() )
+					if ( _alive( n ) ) _os << "{id: " << n->id << ", info: " << n->info << "} ";
+				_os << "]";
+				return _os;
+			}
+	};
+}
+
+#endif
@@ -0,0 +1,249 @@
+/**
+ * @file    layout.h
+ * @brief   Defining and implementing the storage layouts of DAL and DSAL.
+ */
+
+#ifndef _LAYOUT_H_
+#define _LAYOUT_H_
+
+#include <algorithm>   // std::copy, std::move, std::move_backward
+#include <cstring>     // std::memmove
+#include <type_traits> // std::is_trivially_copyable
+#include <utility>     // std::move
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace ac
+{
+	/**
+	 * @brief      Array of structures: each key is stored side by side with
+	 *             its data (default).
+	 */
+	struct AoS {};
+
+	/**
+	 * @brief      Structure of arrays: keys are stored in their own array and
+	 *             data in a parallel one, so searches only touch the keys.
+	 */
+	struct SoA {};
+
+	/**
+	 * @brief      Moves the elements in [_first, _last) _n positions to the
+	 *             right (_n > 0) or to the left (_n < 0) in a single bulk
+	 *             move. Trivially copyable elements are moved with memmove,
+	 *             the others with move assignment.
+	 */
+	template< typename T >
+	void shift_block ( T *_data, int _first, int _last, int _n, std::true_type )
+	{
+		std::memmove( static_cast< void * >( _data + _first + _n ), _data + _first,
+					  ( _last - _first ) * sizeof( T ) );
+	}
+
+	template< typename T >
+	void shift_block ( T *_data, int _first, int _last, int _n, std::false_type )
+	{
+		if ( _n > 0 ) std::move_backward( _data + _first, _data + _last, _data + _last + _n );
+		else std::move( _data + _first, _data + _last, _data + _first + _n );
+	}
+
+	template< typename T >
+	void shift_block ( T *_data, int _first, int _last, int _n )
+	{
+		shift_block( _data, _first, _last, _n, std::is_trivially_copyable< T >() );
+	}
+
+	/**
+	 * @brief      Linear search for an integer key, comparing 16 bytes of keys
+	 *             at a time with SSE2 when available.
+	 *
+	 * @param[in]  _keys  Contiguous array of keys.
+	 * @param[in]  _n     Number of keys.
+	 * @param[in]  _x     Key to be found.
+	 *
+	 * @tparam     Key    Integral type of 1, 2, 4 or 8 bytes.
+	 *
+	 * @return     Position of the key, or -1 if not found.
+	 */
+	template< typename Key >
+	int simd_find ( const Key *_keys, int _n, Key _x )
+	{
+		int i(0);
+#if defined(__SSE2__)
+		const int lanes = 16 / sizeof( Key );
+		__m128i needle;
+		switch ( sizeof( Key ) )
+		{
+			case 1: needle = _mm_set1_epi8( static_cast< char >( _x ) ); break;
+			case 2: needle = _mm_set1_epi16( static_cast< short >( _x ) ); break;
+			case 4: needle = _mm_set1_epi32( static_cast< int >( _x ) ); break;
+			default: needle = _mm_set1_epi64x( static_cast< long long >( _x ) ); break;
+		}
+		for ( ; i + lanes <= _n; i += lanes )
+		{
+			__m128i block = _mm_loadu_si128( reinterpret_cast< const __m128i * >( _keys + i ) );
+			__m128i eq;
+			switch ( sizeof( Key ) )
+			{
+				case 1: eq = _mm_cmpeq_epi8( block, needle ); break;
+				case 2: eq = _mm_cmpeq_epi16( block, needle ); break;
+				case 4: eq = _mm_cmpeq_epi32( block, needle ); break;
+				default:
+					// SSE2 has no 64 bit compare: both 32 bit halves must match
+					eq = _mm_cmpeq_epi32( block, needle );
+					eq = _mm_and_si128( eq, _mm_shuffle_epi32( eq, _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+					break;
+			}
+			int mask = _mm_movemask_epi8( eq );
+			if ( mask != 0 ) return i + __builtin_ctz( mask ) / int( sizeof( Key ) );
+		}
+#endif
+		for ( ; i < _n; ++i )
+			if ( _keys[i] == _x ) return i;
+		return -1;
+	}
+
+	/**
+	 * @brief      Storage area of a dictionary, in the given layout.
+	 *
+	 * @tparam     Key     Key of the element.
+	 * @tparam     Data    Value associated to the key.
+	 * @tparam     Layout  AoS or SoA.
+	 */
+	template< typename Key, typename Data, typename Layout >
+	class Store;
+
+	template< typename Key, typename Data >
+	class Store< Key, Data, AoS >
+	{
+		public:
+
+			/**
+			 * @brief      Node structure representing pair key-information
+			 */
+			struct NodeAL
+			{
+				Key id; // The key is a simple integer
+				Data info; // The information is a chain of chars
+			};
+
+			explicit Store ( int _cap ) : mpt_Data( new NodeAL[_cap] ) { /* empty */ }
+
+			/**
+			 * @brief      Copies the first _length elements of another
+			 *             storage area to a new one with capacity _cap.
+			 */
+			Store ( const Store & _other, int _length, int _cap ) : mpt_Data( new NodeAL[_cap] )
+			{
+				std::copy( _other.mpt_Data, _other.mpt_Data + _length, mpt_Data );
+			}
+
+			~Store () { delete [] mpt_Data; }
+			Store ( const Store & ) = delete;
+			Store & operator= ( const Store & ) = delete;
+
+			Key & key ( int _i ) { return mpt_Data[_i].id; }
+			const Key & key ( int _i ) const { return mpt_Data[_i].id; }
+			Data & info ( int _i ) { return mpt_Data[_i].info; }
+			const Data & info ( int _i ) const { return mpt_Data[_i].info; }
+
+			/**
+			 * @brief      Moves the element at _src to the slot _dst.
+			 */
+			void move ( int _dst, int _src ) { mpt_Data[_dst] = std::move( mpt_Data[_src] ); }
+
+			/**
+			 * @brief      Moves the elements in [_first, _last) _n positions.
+			 */
+			void shift ( int _first, int _last, int _n ) { shift_block( mpt_Data, _first, _last, _n ); }
+
+			/**
+			 * @brief      Moves the first _length elements to a new storage
+			 *             area with capacity _cap.
+			 */
+			void reallocate ( int _length, int _cap )
+			{
+				NodeAL *temp = new NodeAL[_cap];
+				std::move( mpt_Data, mpt_Data + _length, temp );
+				delete [] mpt_Data;
+				mpt_Data = temp;
+			}
+
+		private:
+			NodeAL *mpt_Data; // Storage area: dinamic allocated array
+	};
+
+	template< typename Key, typename Data >
+	class Store< Key, Data, SoA >
+	{
+		public:
+
+			explicit Store ( int _cap ) : mpt_Keys( new Key[_cap] ), mpt_Info( new Data[_cap] ) { /* empty */ }
+
+			/**
+			 * @brief      Copies the first _length elements of other
+			 *             storage areas to new ones with capacity _cap.
+			 */
+			Store ( const Store & _other, int _length, int _cap ) : mpt_Keys( new Key[_cap] ), mpt_Info( new Data[_cap] )
+			{
+				std::copy( _other.mpt_Keys, _other.mpt_Keys + _length, mpt_Keys );
+				std::copy( _other.mpt_Info, _other.mpt_Info + _length, mpt_Info );
+			}
+
+			~Store () { delete [] mpt_Keys; delete [] mpt_Info; }
+			Store ( const Store & ) = delete;
+			Store & operator= ( const Store & ) = delete;
+
+			Key & key ( int _i ) { return mpt_Keys[_i]; }
+			const Key & key ( int _i ) const { return mpt_Keys[_i]; }
+			Data & info ( int _i ) { return mpt_Info[_i]; }
+			const Data & info ( int _i ) const { return mpt_Info[_i]; }
+
+			/**
+			 * @brief      Contiguous array with the keys only.
+			 */
+			const Key * keys ( void ) const { return mpt_Keys; }
+
+			/**
+			 * @brief      Moves the element at _src to the slot _dst.
+			 */
+			void move ( int _dst, int _src )
+			{
+				mpt_Keys[_dst] = std::move( mpt_Keys[_src] );
+				mpt_Info[_dst] = std::move( mpt_Info[_src] );
+			}
+
+			/**
+			 * @brief      Moves the elements in [_first, _last) _n positions.
+			 */
+			void shift ( int _first, int _last, int _n )
+			{
+				shift_block( mpt_Keys, _first, _last, _n );
+				shift_block( mpt_Info, _first, _last, _n );
+			}
+
+			/**
+			 * @brief      Moves the first _length elements to new storage
+			 *             areas with capacity _cap.
+			 */
+			void reallocate ( int _length, int _cap )
+			{
+				Key *keys = new Key[_cap];
+				Data *info = new Data[_cap];
+				std::move( mpt_Keys, mpt_Keys + _length, keys );
+				std::move( mpt_Info, mpt_Info + _length, info );
+				delete [] mpt_Keys;
+				delete [] mpt_Info;
+				mpt_Keys = keys;
+				mpt_Info = info;
+			}
+
+		private:
+			Key *mpt_Keys;  // Keys, contiguous
+			Data *mpt_Info; // Data, parallel to the keys
+	};
+}
+
+#endif
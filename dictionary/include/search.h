@@ -0,0 +1,149 @@
+/**
+ * @file    search.h
+ * @brief   Defining and implementing the search strategies of DSAL.
+ */
+
+#ifndef _SEARCH_H_
+#define _SEARCH_H_
+
+#include <algorithm> // std::min, std::max
+
+namespace ac
+{
+	/**
+	 * @brief      Binary search over the whole array (default).
+	 */
+	struct BinarySearch {};
+
+	/**
+	 * @brief      Interpolation search: guesses the position of the key from
+	 *             the keys at both ends of the range, so it takes about
+	 *             log log n steps on evenly spread numeric keys. Falls back to
+	 *             bisection on steps that do not halve the range, so it is
+	 *             never worse than twice the binary search. Other key types,
+	 *             or comparators other than std::less, use the binary search.
+	 */
+	struct InterpolationSearch {};
+
+	/**
+	 * @brief      Exponential (galloping) search from the position of the
+	 *             previous search: steps of 1, 2, 4, ... towards the key, then
+	 *             a binary search over the last step. Costs O(log d) for a key
+	 *             d positions away from the previous one, which suits
+	 *             mostly-sequential access.
+	 */
+	struct GallopingSearch {};
+
+	/**
+	 * @brief      Picks one of the above for every search: galloping while
+	 *             the recent searches land close to each other, else
+	 *             interpolation if a sample of the keys shows they are evenly
+	 *             spread, else binary.
+	 */
+	struct AdaptiveSearch {};
+
+	/**
+	 * @brief      Binary search for the first key not less than _x in
+	 *             [_first, _last).
+	 *
+	 * @param[in]  _keys   Anything with key(i), e.g. a Store.
+	 * @param[in]  _first  First position of the range.
+	 * @param[in]  _last   Past the last position of the range.
+	 * @param[in]  _x      Key to be found.
+	 * @param[in]  _comp   Comparator of the keys.
+	 *
+	 * @return     Position in [_first, _last].
+	 */
+	template< typename Keys, typename Key, typename KeyComparator >
+	int binary_lower_bound ( const Keys & _keys, int _first, int _last, const Key & _x, KeyComparator _comp )
+	{
+		while ( _first < _last )
+		{
+			int mid = _first + ( _last - _first ) / 2;
+			if ( _comp( _keys.key(mid), _x ) ) _first = mid + 1;
+			else _last = mid;
+		}
+		return _first;
+	}
+
+	/**
+	 * @brief      Interpolation search for the first key not less than _x
+	 *             in [0, _n), for numeric keys in increasing order.
+	 *
+	 * @return     Position in [0, _n].
+	 */
+	template< typename Keys, typename Key >
+	int interpolation_lower_bound ( const Keys & _keys, int _n, const Key & _x )
+	{
+		int left(0), right( _n );
+		bool guess = true;
+		while ( left < right )
+		{
+			int mid;
+			if ( guess )
+			{
+				const Key & low = _keys.key(left);
+				const Key & high = _keys.key(right - 1);
+				if ( not ( low < _x ) ) return left;
+				if ( high < _x ) return right;
+				// low < _x <= high: the answer is in (left, right - 1]
+				double span = double( high ) - double( low );
+				double frac = span > 0 ? ( double( _x ) - double( low ) ) / span : -1.0;
+				// Distinct keys may be equal as doubles (e.g. integers above 2^53): bisects instead
+				if ( not ( frac >= 0 and frac <= 1 ) ) mid = left + ( right - left ) / 2;
+				else mid = left + 1 + int( frac * ( right - left - 2 ) );
+				mid = std::min( std::max( mid, left + 1 ), right - 1 );
+			}
+			else mid = left + ( right - left ) / 2;
+
+			int before = right - left;
+			if ( _keys.key(mid) < _x ) left = mid + 1;
+			else right = mid;
+			// Bisects next if the guess did not halve the range
+			guess = not guess or 2 * ( right - left ) <= before;
+		}
+		return left;
+	}
+
+	/**
+	 * @brief      Exponential search for the first key not less than _x in
+	 *             [0, _n), starting from _from.
+	 *
+	 * @return     Position in [0, _n].
+	 */
+	template< typename Keys, typename Key, typename KeyComparator >
+	int galloping_lower_bound ( const Keys & _keys, int _n, int _from, const Key & _x, KeyComparator _comp )
+	{
+		_from = std::min( std::max( _from, 0 ), _n );
+		int lo, hi, step(1);
+		if ( _from < _n and _comp( _keys.key(_from), _x ) )
+		{
+			// The answer is after _from
+			lo = _from + 1;
+			int probe = lo;
+			while ( probe < _n and _comp( _keys.key(probe), _x ) )
+			{
+				lo = probe + 1;
+				probe = lo + step;
+				step *= 2;
+			}
+			hi = std::min( probe, _n );
+		}
+		else
+		{
+			// The answer is _from or before it
+			hi = _from;
+			int probe = hi - 1;
+			while ( probe >= 0 and not _comp( _keys.key(probe), _x ) )
+			{
+				hi = probe;
+				probe = hi - step;
+				step *= 2;
+			}
+			lo = std::max( probe + 1, 0 );
+		}
+		return binary_lower_bound( _keys, lo, hi, _x, _comp );
+	}
+}
+
+#endif
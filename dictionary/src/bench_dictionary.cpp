@@ -0,0 +1,875 @@
+/**
+ * @file    bench_dictionary.cpp
+ * @brief   Timing the operations of the dictionaries.
+ */
+
+#include <iostream>
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <utility>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <cstdio>
+#include <cassert>
+#include <fstream>
+#include <unistd.h> // sysconf
+
+#include "dal.h"
+#include "dhal.h"
+#include "dsal.h"
+#include "dbt.h"
+#include "dsl.h"
+#include "dlsm.h"
+#include "dpma.h"
+#include "dost.h"
+#include "dcow.h"
+#include "dmap.h"
+#include "dfc.h"
+
+using namespace ac;
+
+/**
+ * @brief      Runs a function a few times and returns its average running time.
+ *
+ * @param[in]  runs  How many times the function is run.
+ * @param[in]  f     Function to be timed.
+ *
+ * @tparam     Func  Callable with no arguments.
+ *
+ * @return     Average running time, in milliseconds.
+ */
+template< typename Func >
+double average_time( int runs, Func f )
+{
+    double time_average = 0.0;
+    for( int k = 1; k <= runs; ++k )
+    {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        auto end = std::chrono::steady_clock::now();
+        time_average += ( std::chrono::duration< double, std::milli >( end - start ).count() - time_average ) / k;
+    }
+    return time_average;
+}
+
+/**
+ * @brief      Prints one line of the results table.
+ */
+void report( const std::string & structure, const std::string & scenario, long n, double time )
+{
+    std::cout << structure << ", " << scenario << ", " << n << ", " << time << std::endl;
+}
+
+/**
+ * @brief      Sustained insertion of increasing keys, starting from the
+ *             default capacity (the dictionary grows as needed) and from a
+ *             dictionary with enough capacity reserved.
+ *
+ * @tparam     Dict  DAL or DSAL.
+ */
+template< typename Dict >
+void bench_growth( const std::string & name, long n, int runs )
+{
+    report( name, "insert growing", n, average_time( runs, [n]()
+    {
+        Dict dict;
+        for( long i = 0; i < n; ++i ) dict.insert( i, i );
+    } ) );
+
+    report( name, "insert reserved", n, average_time( runs, [n]()
+    {
+        Dict dict;
+        dict.reserve( n );
+        for( long i = 0; i < n; ++i ) dict.insert( i, i );
+    } ) );
+}
+
+/**
+ * @brief      Throughput of search() with random keys, half of them misses,
+ *             using the binary search and the read-optimized (Eytzinger)
+ *             mode. Sizes go from the L1 cache to four times the last
+ *             level cache.
+ */
+void bench_search( int runs )
+{
+    long l1 = sysconf( _SC_LEVEL1_DCACHE_SIZE );
+    long llc = sysconf( _SC_LEVEL3_CACHE_SIZE );
+    if ( l1 <= 0 ) l1 = 32 * 1024;
+    if ( llc <= 0 ) llc = 32 * 1024 * 1024;
+    const long queries = 1000000;
+    const long node = 2 * sizeof( long ); // Key and data of a DSAL< long, long >.
+
+    std::mt19937 g( 42 );
+    for( long n = l1 / node; n <= 4 * llc / node; n *= 2 )
+    {
+        DSAL< long, long > dict( n );
+        for( long i = 0; i < n; ++i ) dict.insert( 2 * i, i );
+
+        std::uniform_int_distribution< long > dist( 0, 2 * n - 1 );
+        std::vector< long > keys( queries );
+        for( auto & k : keys ) k = dist( g );
+
+        long sink = 0, data = 0;
+        for( auto mode : { false, true } )
+        {
+            dict.set_read_optimized( mode );
+            auto t = average_time( runs, [&]()
+            {
+                for( auto k : keys ) sink += dict.search( k, data );
+            } );
+            report( "DSAL", mode ? "search 1M eytzinger" : "search 1M binary", n, t );
+        }
+        if ( sink == 42 ) std::cerr << ""; // Keeps the searches from being optimized away.
+    }
+}
+
+/**
+ * @brief      Mixed workload: the dictionary is loaded with n increasing
+ *             even keys, then n random operations are timed, half of them
+ *             insertions and half searches.
+ *
+ * @tparam     Dict  Any dictionary with the DAL interface.
+ */
+template< typename Dict >
+void bench_mixed( const std::string & name, long n, int runs )
+{
+    std::mt19937 g( 42 );
+    std::uniform_int_distribution< long > dist( 0, 4 * n );
+    std::vector< long > keys( n );
+    for( auto & k : keys ) k = dist( g );
+
+    double time_average = 0.0;
+    for( int k = 1; k <= runs; ++k )
+    {
+        Dict dict;
+        for( long i = 0; i < n; ++i ) dict.insert( 2 * i, i );
+
+        long sink = 0, data = 0;
+        auto start = std::chrono::steady_clock::now();
+        for( long i = 0; i < n; ++i )
+        {
+            if ( i % 2 ) dict.insert( keys[i], i );
+            else sink += dict.search( keys[i], data );
+        }
+        auto end = std::chrono::steady_clock::now();
+        time_average += ( std::chrono::duration< double, std::milli >( end - start ).count() - time_average ) / k;
+        if ( sink == 42 ) std::cerr << "";
+    }
+    report( name, "mixed insert/search", n, time_average );
+}
+
+/**
+ * @brief      Unsorted dictionaries: n distinct random keys are inserted,
+ *             searched (half of the searches miss) and removed in a random
+ *             order, which moves the last element to each gap.
+ *
+ * @tparam     Dict  DAL or DHAL.
+ */
+template< typename Dict >
+void bench_hashed( const std::string & name, long n, int runs )
+{
+    std::mt19937 g( 42 );
+    std::vector< long > keys( n );
+    for( long i = 0; i < n; ++i ) keys[i] = 2 * i;
+    std::shuffle( keys.begin(), keys.end(), g );
+    std::vector< long > order( keys );
+    std::shuffle( order.begin(), order.end(), g );
+
+    long sink = 0, data = 0;
+    double insert = 0.0, search = 0.0, remove = 0.0;
+    for( int k = 1; k <= runs; ++k )
+    {
+        Dict dict;
+        auto t0 = std::chrono::steady_clock::now();
+        for( long i = 0; i < n; ++i ) dict.insert( keys[i], i );
+        auto t1 = std::chrono::steady_clock::now();
+        for( long i = 0; i < n; ++i ) sink += dict.search( order[i] + ( i % 2 ), data );
+        auto t2 = std::chrono::steady_clock::now();
+        for( long i = 0; i < n; ++i ) sink += dict.remove( order[i], data );
+        auto t3 = std::chrono::steady_clock::now();
+        insert += ( std::chrono::duration< double, std::milli >( t1 - t0 ).count() - insert ) / k;
+        search += ( std::chrono::duration< double, std::milli >( t2 - t1 ).count() - search ) / k;
+        remove += ( std::chrono::duration< double, std::milli >( t3 - t2 ).count() - remove ) / k;
+    }
+    if ( sink == 42 ) std::cerr << "";
+    report( name, "random insertion", n, insert );
+    report( name, "random search", n, search );
+    report( name, "random removal", n, remove );
+}
+
+/**
+ * @brief      Order statistics: the dictionary is loaded with n increasing
+ *             even keys, then n random operations are timed, a quarter
+ *             each of insertions, removals, rank() and select(); finally 1M
+ *             rank() and select() calls are timed with no updates.
+ *
+ * @tparam     Dict  DSAL or DOST.
+ */
+template< typename Dict >
+void bench_rank( const std::string & name, long n, int runs )
+{
+    std::mt19937 g( 42 );
+    std::uniform_int_distribution< long > dist( 0, 2 * n );
+    std::vector< long > keys( n );
+    for( auto & k : keys ) k = dist( g );
+    std::vector< long > queries( 1000000 );
+    for( auto & q : queries ) q = dist( g );
+
+    double mixed_time = 0.0, query_time = 0.0;
+    for( int k = 1; k <= runs; ++k )
+    {
+        Dict dict;
+        for( long i = 0; i < n; ++i ) dict.insert( 2 * i, i );
+
+        long sink = 0, data = 0;
+        auto start = std::chrono::steady_clock::now();
+        for( long i = 0; i < n; ++i )
+        {
+            switch ( i % 4 )
+            {
+                case 0: dict.insert( keys[i], i ); break;
+                case 1: dict.remove( keys[i], data ); break;
+                case 2: sink += dict.rank( keys[i] ); break;
+                default:
+                    assert( dict.size() > 0 );
+                    dict.select( int( keys[i] % dict.size() ), data ); sink += data; break;
+            }
+        }
+        auto end = std::chrono::steady_clock::now();
+        mixed_time += ( std::chrono::duration< double, std::milli >( end - start ).count() - mixed_time ) / k;
+
+        assert( dict.size() > 0 );
+        start = std::chrono::steady_clock::now();
+        for( auto q : queries )
+        {
+            dict.select( int( q % dict.size() ), data );
+            sink += dict.rank( q ) + data;
+        }
+        end = std::chrono::steady_clock::now();
+        query_time += ( std::chrono::duration< double, std::milli >( end - start ).count() - query_time ) / k;
+        if ( sink == 42 ) std::cerr << "";
+    }
+    report( name, "mixed insert/remove/rank/select", n, mixed_time );
+    report( name, "rank + select 1M", n, query_time );
+}
+
+/**
+ * @brief      Merging a random batch of n / 50 new keys into a DSAL with n
+ *             keys, with merge_insert() and with one insert() per key.
+ */
+void bench_merge( long n, long max_linear, int runs )
+{
+    std::mt19937 g( 42 );
+    std::uniform_int_distribution< long > dist( 0, n - 1 );
+    std::vector< std::pair< long, long > > batch( n / 50 );
+    for( auto & p : batch ) { p.first = 2 * dist( g ) + 1; p.second = p.first; }
+    std::sort( batch.begin(), batch.end() );
+
+    std::vector< std::pair< long, long > > stored( n );
+    for( long i = 0; i < n; ++i ) stored[i] = std::make_pair( 2 * i, i );
+
+    for( auto per_key : { false, true } )
+    {
+        if ( per_key and n > max_linear ) continue;
+        double time_average = 0.0;
+        for( int k = 1; k <= runs; ++k )
+        {
+            DSAL< long, long > dict;
+            dict.bulk_load( stored.begin(), stored.end() );
+            auto start = std::chrono::steady_clock::now();
+            if ( per_key ) for( auto & p : batch ) dict.insert( p.first, p.second );
+            else dict.merge_insert( batch.begin(), batch.end() );
+            auto end = std::chrono::steady_clock::now();
+            time_average += ( std::chrono::duration< double, std::milli >( end - start ).count() - time_average ) / k;
+        }
+        report( "DSAL", per_key ? "merge n/50 per key insert" : "merge n/50 merge_insert", n, time_average );
+    }
+}
+
+/**
+ * @brief      Throughput of search() with random keys, half of them misses,
+ *             with the keys stored next to std::string data (AoS) and in
+ *             their own array (SoA).
+ *
+ * @tparam     Dict  DAL or DSAL, any layout.
+ */
+template< typename Dict >
+void bench_layout( const std::string & name, long n, long queries, int runs )
+{
+    Dict dict( n );
+    for( long i = 0; i < n; ++i ) dict.insert( 2 * i, std::string( 32, 'x' ) );
+
+    std::mt19937 g( 42 );
+    std::uniform_int_distribution< long > dist( 0, 2 * n - 1 );
+    std::vector< long > keys( queries );
+    for( auto & k : keys ) k = dist( g );
+
+    long sink = 0;
+    std::string data;
+    report( name, "search string data", n, average_time( runs, [&]()
+    {
+        for( auto k : keys ) sink += dict.search( k, data );
+    } ) );
+    if ( sink == 42 ) std::cerr << "";
+}
+
+/**
+ * @brief      Throughput of successor() of random keys that are not stored:
+ *             the dictionary holds even keys and the queries are odd.
+ *
+ * @tparam     Dict  Any dictionary with the DAL interface.
+ */
+template< typename Dict >
+void bench_successor( const std::string & name, long n, long queries, int runs )
+{
+    Dict dict;
+    for( long i = 0; i < n; ++i ) dict.insert( 2 * i, i );
+
+    std::mt19937 g( 42 );
+    std::uniform_int_distribution< long > dist( 0, n - 1 );
+    std::vector< long > keys( queries );
+    for( auto & k : keys ) k = 2 * dist( g ) + 1;
+
+    long sink = 0, y;
+    report( name, "successor absent key", n, average_time( runs, [&]()
+    {
+        for( auto k : keys ) if ( dict.successor( k, y ) ) sink += y;
+    } ) );
+    if ( sink == 42 ) std::cerr << "";
+}
+
+/**
+ * @brief      Throughput of min() and max() of a DAL with n keys, which
+ *             are kept by insert() and remove() instead of searched.
+ */
+void bench_minmax( long n, int runs )
+{
+    DAL< long, long > dict;
+    for( long i = 0; i < n; ++i ) dict.insert( ( i * 7919 ) % n, i );
+
+    long sink = 0;
+    report( "DAL", "min + max 1M", n, average_time( runs, [&]()
+    {
+        for( long i = 0; i < 1000000; ++i ) sink += dict.min() + dict.max();
+    } ) );
+    if ( sink == 42 ) std::cerr << "";
+}
+
+/**
+ * @brief      Sorted distinct keys, about n of them, that are evenly spread
+ *             (uniform), grouped in dense clusters (clustered) or with gaps
+ *             that grow without bound (adversarial, cubes of a random walk).
+ */
+std::vector< long > make_keys( const std::string & name, long n, std::mt19937_64 & g )
+{
+    std::vector< long > keys( n );
+    if ( name == "uniform" )
+    {
+        std::uniform_int_distribution< long > d( 0, 1L << 50 );
+        for( auto & k : keys ) k = d( g );
+    }
+    else if ( name == "clustered" )
+    {
+        std::uniform_int_distribution< long > center( 0, 1L << 50 );
+        std::normal_distribution< double > spread( 0.0, 1000.0 );
+        long c = 0;
+        for( long i = 0; i < n; ++i )
+        {
+            if ( i % 1000 == 0 ) c = center( g );
+            keys[i] = c + long( spread( g ) );
+        }
+    }
+    else
+    {
+        std::uniform_int_distribution< long > step( 1, 3 );
+        long walk = 0;
+        for( auto & k : keys ) { walk += step( g ); k = walk * walk * walk / 64; }
+    }
+    std::sort( keys.begin(), keys.end() );
+    keys.erase( std::unique( keys.begin(), keys.end() ), keys.end() );
+    return keys;
+}
+
+/**
+ * @brief      Throughput of search() of stored keys with the binary search,
+ *             the Eytzinger layout and the learned index, over the key
+ *             distributions of make_keys().
+ */
+void bench_learned( long n, int runs )
+{
+    std::mt19937_64 g( 42 );
+    for( auto dist : { "uniform", "clustered", "adversarial" } )
+    {
+        std::string name( dist );
+        auto keys = make_keys( name, n, g );
+
+        std::vector< std::pair< long, long > > pairs;
+        for( auto k : keys ) pairs.push_back( std::make_pair( k, k ) );
+        DSAL< long, long > dict;
+        dict.bulk_load( pairs.begin(), pairs.end() );
+
+        std::uniform_int_distribution< std::size_t > pick( 0, keys.size() - 1 );
+        std::vector< long > queries( 1000000 );
+        for( auto & q : queries ) q = keys[ pick( g ) ];
+
+        long sink = 0, data = 0;
+        for( auto mode : { "binary", "eytzinger", "learned" } )
+        {
+            std::string m( mode );
+            dict.set_read_optimized( m == "eytzinger" );
+            dict.set_learned_index( m == "learned" );
+            dict.search( keys[0], data ); // Builds the layout or the model outside the timing.
+            report( "DSAL", "search 1M " + m + " " + name, long( keys.size() ), average_time( runs, [&]()
+            {
+                for( auto q : queries ) sink += dict.search( q, data );
+            } ) );
+        }
+        if ( sink == 42 ) std::cerr << "";
+    }
+}
+
+/**
+ * @brief      Throughput of 1M search() calls of stored keys with one DSAL
+ *             search strategy, over the key distributions of make_keys()
+ *             and three access patterns: random keys, every key in
+ *             ascending order (sequential) and a random walk of up to 16
+ *             positions per step (local).
+ *
+ * @tparam     Search  Search strategy of the DSAL.
+ */
+template< typename Search >
+void bench_strategy( const std::string & strategy, long n, int runs )
+{
+    std::mt19937_64 g( 42 );
+    for( auto dist : { "uniform", "clustered", "adversarial" } )
+    {
+        std::string name( dist );
+        auto keys = make_keys( name, n, g );
+        std::vector< std::pair< long, long > > pairs;
+        for( auto k : keys ) pairs.push_back( std::make_pair( k, k ) );
+        DSAL< long, long, std::less< long >, AoS, Search > dict;
+        dict.bulk_load( pairs.begin(), pairs.end() );
+
+        long size = long( keys.size() );
+        for( auto access : { "random", "sequential", "local" } )
+        {
+            std::string a( access );
+            std::vector< long > queries( 1000000 );
+            std::uniform_int_distribution< long > pick( 0, size - 1 ), step( -16, 16 );
+            long pos = 0;
+            for( long i = 0; i < long( queries.size() ); ++i )
+            {
+                if ( a == "random" ) pos = pick( g );
+                else if ( a == "sequential" ) pos = i % size;
+                else pos = std::min( std::max( pos + step( g ), 0L ), size - 1 );
+                queries[i] = keys[pos];
+            }
+
+            long sink = 0, data = 0;
+            report( "DSAL " + strategy, "search 1M " + a + " " + name, size, average_time( runs, [&]()
+            {
+                for( auto q : queries ) sink += dict.search( q, data );
+            } ) );
+            if ( sink == 42 ) std::cerr << "";
+        }
+    }
+}
+
+/**
+ * @brief      Write-heavy ingestion: n distinct keys inserted in random
+ *             order, then 1M searches of random keys, half of them misses.
+ *
+ * @tparam     Dict  DSAL, DLSM, DPMA or DBT.
+ * @tparam     Prep  Called on the loaded dictionary before the searches.
+ */
+template< typename Dict, typename Prep >
+void bench_ingest( const std::string & name, long n, int runs, Prep prep )
+{
+    std::mt19937 g( 42 );
+    std::vector< long > keys( n );
+    for( long i = 0; i < n; ++i ) keys[i] = 2 * i;
+    std::shuffle( keys.begin(), keys.end(), g );
+    std::uniform_int_distribution< long > dist( 0, 2 * n - 1 );
+    std::vector< long > queries( 1000000 );
+    for( auto & q : queries ) q = dist( g );
+
+    double insert_time = 0.0, search_time = 0.0;
+    for( int k = 1; k <= runs; ++k )
+    {
+        Dict dict;
+        auto start = std::chrono::steady_clock::now();
+        for( auto key : keys ) dict.insert( key, key );
+        auto end = std::chrono::steady_clock::now();
+        insert_time += ( std::chrono::duration< double, std::milli >( end - start ).count() - insert_time ) / k;
+
+        prep( dict );
+        long sink = 0, data = 0;
+        start = std::chrono::steady_clock::now();
+        for( auto q : queries ) sink += dict.search( q, data );
+        end = std::chrono::steady_clock::now();
+        search_time += ( std::chrono::duration< double, std::milli >( end - start ).count() - search_time ) / k;
+        if ( sink == 42 ) std::cerr << "";
+    }
+    report( name, "insert random keys", n, insert_time );
+    report( name, "search 1M after random inserts", n, search_time );
+}
+
+/**
+ * @brief      DSAL behind a single lock, the baseline for the concurrent
+ *             benchmark.
+ */
+class LockedDSAL
+{
+    public:
+        bool insert( long k, long d ) { std::lock_guard< std::mutex > g( m_mutex ); return m_dict.insert( k, d ); }
+        bool remove( long k, long & d ) { std::lock_guard< std::mutex > g( m_mutex ); return m_dict.remove( k, d ); }
+        bool search( long k, long & d ) { std::lock_guard< std::mutex > g( m_mutex ); return m_dict.search( k, d ); }
+    private:
+        std::mutex m_mutex;
+        DSAL< long, long > m_dict;
+};
+
+/**
+ * @brief      Concurrent mixed workload: the dictionary is loaded with half
+ *             of n keys, then a fixed number of operations (80% searches,
+ *             10% insertions, 10% removals of random keys) is split among
+ *             the threads.
+ *
+ * @tparam     Dict  DSL or LockedDSAL.
+ */
+template< typename Dict >
+void bench_concurrent( const std::string & name, long n, long ops, int runs )
+{
+    for( int threads = 1; threads <= 32; threads *= 2 )
+    {
+        double time_average = 0.0;
+        for( int k = 1; k <= runs; ++k )
+        {
+            Dict dict;
+            for( long i = 0; i < n; i += 2 ) dict.insert( i, i );
+
+            std::vector< std::thread > pool;
+            auto start = std::chrono::steady_clock::now();
+            for( int t = 0; t < threads; ++t )
+                pool.emplace_back( [&dict, n, ops, threads, t]()
+                {
+                    std::mt19937 g( t );
+                    std::uniform_int_distribution< long > dist( 0, n - 1 );
+                    long data, sink = 0;
+                    for( long i = 0; i < ops / threads; ++i )
+                    {
+                        auto key = dist( g );
+                        switch ( i % 10 )
+                        {
+                            case 0: dict.insert( key, key ); break;
+                            case 1: dict.remove( key, data ); break;
+                            default: sink += dict.search( key, data );
+                        }
+                    }
+                    if ( sink == 42 ) std::cerr << "";
+                } );
+            for( auto & th : pool ) th.join();
+            auto end = std::chrono::steady_clock::now();
+            time_average += ( std::chrono::duration< double, std::milli >( end - start ).count() - time_average ) / k;
+        }
+        report( name, "mixed 1M ops " + std::to_string( threads ) + " threads", n, time_average );
+    }
+}
+
+/**
+ * @brief      Startup: n random records are saved as text ("key value" per
+ *             line) and as a DMAP file; then rebuilding a DSAL from the text
+ *             is timed against mapping the DMAP file, followed by 1M
+ *             searches of random keys in each.
+ */
+void bench_startup( long n, int runs )
+{
+    std::string text = "/tmp/bench_dictionary_" + std::to_string( getpid() ) + ".txt";
+    std::string mapped = "/tmp/bench_dictionary_" + std::to_string( getpid() ) + ".dmap";
+    std::mt19937_64 g( 42 );
+    std::uniform_int_distribution< long > dist( 0, 4 * n );
+    {
+        std::ofstream out( text );
+        DSAL< long, long > dict;
+        std::vector< std::pair< long, long > > pairs;
+        for( long i = 0; i < n; ++i ) { auto k = dist( g ); pairs.push_back( std::make_pair( k, i ) ); out << k << ' ' << i << '\n'; }
+        dict.bulk_load( pairs.begin(), pairs.end() );
+        report( "DMAP", "write file", n, average_time( 1, [&]() { DMAP< long, long >::write( mapped, dict ); } ) );
+    }
+    std::vector< long > queries( 1000000 );
+    for( auto & q : queries ) q = dist( g );
+
+    long sink = 0, data = 0;
+    report( "DSAL", "rebuild from text", n, average_time( runs, [&]()
+    {
+        std::ifstream in( text );
+        std::vector< std::pair< long, long > > pairs;
+        long k, d;
+        while ( in >> k >> d ) pairs.push_back( std::make_pair( k, d ) );
+        DSAL< long, long > dict;
+        dict.bulk_load( pairs.begin(), pairs.end() );
+        sink += dict.size();
+    } ) );
+    report( "DMAP", "open file", n, average_time( runs, [&]()
+    {
+        DMAP< long, long > dict;
+        dict.open( mapped );
+        sink += dict.size();
+    } ) );
+
+    {
+        std::ifstream in( text );
+        std::vector< std::pair< long, long > > pairs;
+        long k, d;
+        while ( in >> k >> d ) pairs.push_back( std::make_pair( k, d ) );
+        DSAL< long, long > dict;
+        dict.bulk_load( pairs.begin(), pairs.end() );
+        report( "DSAL", "search 1M", n, average_time( runs, [&]() { for( auto q : queries ) sink += dict.search( q, data ); } ) );
+    }
+    {
+        DMAP< long, long > dict;
+        dict.open( mapped );
+        report( "DMAP", "search 1M", n, average_time( runs, [&]() { for( auto q : queries ) sink += dict.search( q, data ); } ) );
+    }
+    if ( sink == 42 ) std::cerr << "";
+    std::remove( text.c_str() );
+    std::remove( mapped.c_str() );
+}
+
+/**
+ * @brief      String keys: n long identifiers sharing prefixes
+ *             ("com.example.service-12/tenant-0345/account-000012345678")
+ *             stored in a DSAL and in a DFC. Reports the memory each one
+ *             takes, in KiB (in the time column), with the heap buffers of
+ *             the strings (libstdc++ keeps up to 15 chars inline), and the
+ *             time of 1M searches of stored keys.
+ */
+void bench_strings( long n, int runs )
+{
+    std::mt19937_64 g( 42 );
+    std::uniform_int_distribution< long > service( 0, 49 ), tenant( 0, 999 ), account( 0, 999999999999L );
+    std::vector< std::pair< std::string, long > > pairs;
+    for( long i = 0; i < n; ++i )
+    {
+        char key[80];
+        std::snprintf( key, sizeof( key ), "com.example.service-%02ld/tenant-%04ld/account-%012ld",
+                       service( g ), tenant( g ), account( g ) );
+        pairs.push_back( std::make_pair( std::string( key ), i ) );
+    }
+    std::uniform_int_distribution< std::size_t > pick( 0, pairs.size() - 1 );
+    std::vector< std::string > queries( 1000000 );
+    for( auto & q : queries ) q = pairs[ pick( g ) ].first;
+
+    long sink = 0, data = 0;
+    {
+        DSAL< std::string, long > dict;
+        dict.bulk_load( pairs.begin(), pairs.end() );
+        std::size_t bytes = sizeof( dict ) + dict.capacity() * sizeof( Store< std::string, long, AoS >::NodeAL );
+        for( auto it = dict.begin(); it != dict.end(); ++it )
+            if ( it->id.capacity() > 15 ) bytes += it->id.capacity() + 1;
+        report( "DSAL", "memory KiB", n, bytes / 1024.0 );
+        report( "DSAL", "search 1M strings", n, average_time( runs, [&]() { for( auto & q : queries ) sink += dict.search( q, data ); } ) );
+    }
+    {
+        DFC< long > dict;
+        dict.bulk_load( pairs.begin(), pairs.end() );
+        report( "DFC", "memory KiB", n, dict.memory_usage() / 1024.0 );
+        report( "DFC", "search 1M strings", n, average_time( runs, [&]() { for( auto & q : queries ) sink += dict.search( q, data ); } ) );
+    }
+    if ( sink == 42 ) std::cerr << "";
+}
+
+/**
+ * @brief      Read scaling: the dictionary is loaded with the even keys
+ *             below n, then a fixed number of searches of random keys is
+ *             split among the reader threads while one more thread keeps
+ *             updating the dictionary (a batch of 16 insertions and 16
+ *             removals at a time) until the readers are done.
+ *
+ * @tparam     Dict   LockedDSAL or DCOW.
+ * @tparam     Read   Called with the dictionary, a random generator and the
+ *                    number of searches to run; returns a checksum.
+ * @tparam     Write  Called with the dictionary and a batch number.
+ */
+template< typename Dict, typename Read, typename Write >
+void bench_readers( const std::string & name, long n, long ops, int runs, Read read, Write write )
+{
+    for( int threads = 1; threads <= 64; threads *= 2 )
+    {
+        double time_average = 0.0;
+        for( int k = 1; k <= runs; ++k )
+        {
+            Dict dict;
+            for( long i = 0; i < n; i += 2 ) dict.insert( i, i );
+
+            std::atomic< bool > done( false );
+            std::thread writer( [&dict, &done, &write]()
+            {
+                for( long batch = 0; not done; ++batch ) write( dict, batch );
+            } );
+            std::vector< std::thread > pool;
+            auto start = std::chrono::steady_clock::now();
+            for( int t = 0; t < threads; ++t )
+                pool.emplace_back( [&dict, &read, ops, threads, t]()
+                {
+                    std::mt19937 g( t );
+                    if ( read( dict, g, ops / threads ) == 42 ) std::cerr << "";
+                } );
+            for( auto & th : pool ) th.join();
+            auto end = std::chrono::steady_clock::now();
+            done = true;
+            writer.join();
+            time_average += ( std::chrono::duration< double, std::milli >( end - start ).count() - time_average ) / k;
+        }
+        report( name, "search 1M " + std::to_string( threads ) + " readers + 1 writer", n, time_average );
+    }
+}
+
+int main( int argc, char const **argv )
+{
+    // Maximum input size, maximum input size for workloads that are linear per operation
+    // (DAL insertion, DSAL random insertion) and number of runs.
+    long max_n = argc > 1 ? std::atol( argv[1] ) : 10000000;
+    long max_dal = argc > 2 ? std::atol( argv[2] ) : 100000;
+    int runs = argc > 3 ? std::atoi( argv[3] ) : 3;
+
+    std::cout << "Structure, Scenario, Input Size, Average Time (ms)" << std::endl;
+
+    for( long n = 1000; n <= max_n; n *= 10 )
+    {
+        if ( n <= max_dal ) bench_growth< DAL< long, long > >( "DAL", n, runs );
+        bench_growth< DSAL< long, long > >( "DSAL", n, runs );
+    }
+
+    for( long n = 1000; n <= max_n; n *= 10 )
+    {
+        if ( n <= max_dal ) bench_mixed< DSAL< long, long > >( "DSAL", n, runs );
+        bench_mixed< DBT< long, long > >( "DBT", n, runs );
+    }
+
+    for( long n = 1000; n <= max_n; n *= 10 )
+    {
+        if ( n <= max_dal ) bench_hashed< DAL< long, long > >( "DAL", n, runs );
+        bench_hashed< DHAL< long, long > >( "DHAL", n, runs );
+    }
+
+    for( long n = 1000; n <= max_n; n *= 10 )
+    {
+        if ( n <= max_dal ) bench_rank< DSAL< long, long > >( "DSAL", n, runs );
+        bench_rank< DOST< long, long > >( "DOST", n, runs );
+    }
+
+    for( long n = 1000; n <= max_n; n *= 10 )
+        bench_merge( n, max_dal, runs );
+
+    bench_search( runs );
+
+    for( long n = 1000000; n <= max_n; n *= 10 )
+        bench_learned( n, runs );
+
+    for( long n = 1000; n <= max_n; n *= 100 )
+    {
+        bench_strategy< BinarySearch >( "binary", n, runs );
+        bench_strategy< InterpolationSearch >( "interpolation", n, runs );
+        bench_strategy< GallopingSearch >( "galloping", n, runs );
+        bench_strategy< AdaptiveSearch >( "adaptive", n, runs );
+    }
+
+    for( long n = 1000; n <= max_n; n *= 10 )
+    {
+        if ( n <= max_dal )
+        {
+            bench_minmax( n, runs );
+            bench_successor< DAL< long, long > >( "DAL", n, 1000, runs );
+        }
+        bench_successor< DSAL< long, long > >( "DSAL", n, 1000000, runs );
+    }
+
+    for( long n = 1000; n <= max_n; n *= 10 )
+    {
+        if ( n <= max_dal )
+        {
+            bench_layout< DAL< long, std::string > >( "DAL AoS", n, 1000, runs );
+            bench_layout< DAL< long, std::string, std::less< long >, SoA > >( "DAL SoA", n, 1000, runs );
+        }
+        bench_layout< DSAL< long, std::string > >( "DSAL AoS", n, 1000000, runs );
+        bench_layout< DSAL< long, std::string, std::less< long >, SoA > >( "DSAL SoA", n, 1000000, runs );
+    }
+
+    for( long n = 1000; n <= max_n; n *= 10 )
+    {
+        if ( n <= max_dal ) bench_ingest< DSAL< long, long > >( "DSAL", n, runs, []( DSAL< long, long > & ) {} );
+        bench_ingest< DLSM< long, long > >( "DLSM", n, runs, []( DLSM< long, long > & ) {} );
+        bench_ingest< DLSM< long, long > >( "DLSM compacted", n, runs, []( DLSM< long, long > & d ) { d.compact(); } );
+        bench_ingest< DPMA< long, long > >( "DPMA", n, runs, []( DPMA< long, long > & ) {} );
+        bench_ingest< DBT< long, long > >( "DBT", n, runs, []( DBT< long, long > & ) {} );
+    }
+
+    for( long n = 1000; n <= std::min( max_n, 1000000L ); n *= 10 )
+    {
+        if ( n <= max_dal ) bench_concurrent< LockedDSAL >( "DSAL + mutex", n, 1000000, runs );
+        bench_concurrent< DSL< long, long > >( "DSL", n, 1000000, runs );
+    }
+
+    for( long n = 1000; n <= max_n; n *= 10 )
+        bench_startup( n, runs );
+
+    for( long n = 1000; n <= max_n; n *= 10 )
+        bench_strings( n, runs );
+
+    for( long n = 1000; n <= std::min( max_n, 1000000L ); n *= 10 )
+    {
+        using Cow = DCOW< long, long >;
+        auto search_locked = [n]( LockedDSAL & d, std::mt19937 & g, long count )
+        {
+            std::uniform_int_distribution< long > dist( 0, n - 1 );
+            long sink = 0, data = 0;
+            for( long i = 0; i < count; ++i ) sink += d.search( dist( g ), data );
+            return sink;
+        };
+        auto write_locked = [n]( LockedDSAL & d, long batch )
+        {
+            long data;
+            for( long i = 0; i < 16; ++i ) d.insert( ( 2 * ( batch * 16 + i ) + 1 ) % n, 0 );
+            for( long i = 0; i < 16; ++i ) d.remove( ( 2 * ( batch * 16 + i ) + 1 ) % n, data );
+        };
+        // One snapshot per search, and one per 1000 searches
+        auto search_cow = [n]( Cow & d, std::mt19937 & g, long count )
+        {
+            std::uniform_int_distribution< long > dist( 0, n - 1 );
+            long sink = 0, data = 0;
+            for( long i = 0; i < count; ++i ) sink += d.search( dist( g ), data );
+            return sink;
+        };
+        auto search_snapshot = [n]( Cow & d, std::mt19937 & g, long count )
+        {
+            std::uniform_int_distribution< long > dist( 0, n - 1 );
+            long sink = 0, data = 0;
+            for( long i = 0; i < count; i += 1000 )
+            {
+                auto snap = d.snapshot();
+                for( long j = i; j < std::min( count, i + 1000 ); ++j ) sink += snap->search( dist( g ), data );
+            }
+            return sink;
+        };
+        auto write_cow = [n]( Cow & d, long batch )
+        {
+            d.update( [n, batch]( Cow::Dict & dict )
+            {
+                long data;
+                for( long i = 0; i < 16; ++i ) dict.insert( ( 2 * ( batch * 16 + i ) + 1 ) % n, 0 );
+                for( long i = 0; i < 16; ++i ) dict.remove( ( 2 * ( batch * 16 + i ) + 1 ) % n, data );
+            } );
+        };
+        if ( n <= max_dal ) bench_readers< LockedDSAL >( "DSAL + mutex", n, 1000000, runs, search_locked, write_locked );
+        bench_readers< Cow >( "DCOW", n, 1000000, runs, search_cow, write_cow );
+        bench_readers< Cow >( "DCOW snapshot per 1000", n, 1000000, runs, search_snapshot, write_cow );
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -10,9 +10,29 @@
 #include <algorithm>  // shuffle
 #include <random>     // random_device, mt19937
 #include <iterator>   // std::begin(), std::end()
+#include <string>     // std::to_string
+#include <map>        // std::map
+#include <vector>     // std::vector
+#include <set>        // std::set
+#include <thread>     // std::thread
+#include <atomic>     // std::atomic
+#include <cstdio>     // std::remove
+#include <cstring>    // std::memcpy
+#include <cstddef>    // offsetof
+#include <fstream>    // std::ifstream, std::ofstream
+#include <unistd.h>   // getpid(), truncate()
 
 #include "dal.h"
+#include "dhal.h"
 #include "dsal.h"
+#include "dbt.h"
+#include "dsl.h"
+#include "dlsm.h"
+#include "dpma.h"
+#include "dost.h"
+#include "dcow.h"
+#include "dmap.h"
+#include "dfc.h"
 
 using namespace ac;
 
@@ -28,6 +48,88 @@ class MyKeyComparator
         }
 };
 
+/**
+ * @brief      Checks min, max, successor and predecessor of a dictionary,
+ *             for stored and absent keys, against a std::map with the same
+ *             keys.
+ */
+template< typename Dict >
+void check_order( const Dict & dict, const std::map< int, int > & ref, int lo, int hi )
+{
+    int y;
+    if ( not ref.empty() ) assert( dict.min() == ref.begin()->first and dict.max() == ref.rbegin()->first );
+    for ( auto k = lo; k <= hi; ++k )
+    {
+        auto above = ref.upper_bound( k );
+        assert( dict.successor( k, y ) == ( above != ref.end() ) );
+        if ( above != ref.end() ) assert( y == above->first );
+        auto below = ref.lower_bound( k );
+        assert( dict.predecessor( k, y ) == ( below != ref.begin() ) );
+        if ( below != ref.begin() ) assert( y == ( --below )->first );
+    }
+}
+
+/**
+ * @brief      Checks rank() and select() of a dictionary against a std::map
+ *             with the same keys, for every key in [lo, hi] and every position.
+ */
+template< typename Dict >
+void check_rank( const Dict & dict, const std::map< int, int > & ref, int lo, int hi )
+{
+    int y;
+    for ( auto k = lo; k <= hi; ++k )
+        assert( dict.rank( k ) == int( std::distance( ref.begin(), ref.lower_bound( k ) ) ) );
+    auto it = ref.begin();
+    for ( auto i(0); i < int( ref.size() ); ++i, ++it )
+        assert( dict.select( i, y ) and y == it->first );
+    assert( false == dict.select( -1, y ) and false == dict.select( int( ref.size() ), y ) );
+}
+
+/**
+ * @brief      Checks a DSAL search strategy against a std::map, with
+ *             random, ascending and descending lookups over keys that are
+ *             evenly spread and keys that are clustered.
+ */
+template< typename Dict >
+void check_strategy( void )
+{
+    std::mt19937 g( 29 );
+    for ( auto clustered : { false, true } )
+    {
+        Dict dict;
+        std::map< int, int > ref;
+        int result;
+        std::uniform_int_distribution< int > dist( 0, 100000 );
+        for ( auto i(0); i < 3000; ++i )
+        {
+            auto k = dist( g );
+            if ( clustered ) k = ( k % 10 ) * 1000000 + k % 50;
+            bool fresh = ref.insert( std::make_pair( k, i ) ).second;
+            assert( dict.insert( k, i ) == fresh );
+            if ( i % 5 == 0 )
+            {
+                auto it = ref.lower_bound( dist( g ) );
+                if ( it != ref.end() ) { assert( dict.remove( it->first, result ) and result == it->second ); ref.erase( it ); }
+            }
+        }
+        assert( dict.size() == int( ref.size() ) );
+
+        // Random, then ascending, then descending lookups: the cursor moves every way.
+        std::vector< int > probes;
+        for ( auto i(0); i < 2000; ++i ) probes.push_back( clustered ? ( dist( g ) % 10 ) * 1000000 + dist( g ) % 60 : dist( g ) );
+        for ( auto & p : ref ) { probes.push_back( p.first - 1 ); probes.push_back( p.first ); }
+        for ( auto it = ref.rbegin(); it != ref.rend(); ++it ) probes.push_back( it->first );
+        probes.push_back( -1 );
+        probes.push_back( 1 << 30 );
+        for ( auto k : probes )
+        {
+            auto it = ref.find( k );
+            assert( dict.search( k, result ) == ( it != ref.end() ) and ( it == ref.end() or result == it->second ) );
+            assert( dict.rank( k ) == int( std::distance( ref.begin(), ref.lower_bound( k ) ) ) );
+        }
+    }
+}
+
 int main ( void )
 {
     {
@@ -40,8 +142,8 @@ int main ( void )
     }
 
     {
-        // Testing insert.
-        DAL<int, std::string> dict(3);
+        // Testing insert on a dictionary with fixed capacity.
+        DAL<int, std::string> dict(3, 1.0);
 
         // testing the regular insert
         assert( dict.insert( 1, "AAA" ) );
@@ -55,6 +157,30 @@ int main ( void )
         assert( dict.insert( 4, "DDD" ) == false );
     }
 
+    {
+        // Testing capacity growth, reserve and shrink_to_fit.
+        DAL<int, std::string> dict(2, 1.5);
+        std::string result;
+
+        for ( auto i(0); i < 100; ++i )
+            assert( dict.insert( 99 - i, std::to_string( 99 - i ) ) );
+        assert( dict.size() == 100 );
+        assert( dict.capacity() >= 100 );
+
+        dict.reserve( 500 );
+        assert( dict.capacity() == 500 );
+        dict.reserve( 10 );
+        assert( dict.capacity() == 500 );
+
+        dict.shrink_to_fit();
+        assert( dict.capacity() == 100 );
+        assert( dict.insert( 100, "100" ) );
+        assert( dict.capacity() == 150 );
+
+        for ( auto i(0); i <= 100; ++i )
+            assert( dict.search( i, result ) and result == std::to_string( i ) );
+    }
+
     {
         // Testing search.
         DAL<int, std::string> dict;
@@ -266,8 +392,8 @@ int main ( void )
     }
 
     {
-        // Testing insert.
-        DSAL<int, std::string> dict(3);
+        // Testing insert on a dictionary with fixed capacity.
+        DSAL<int, std::string> dict(3, 1.0);
 
         // testing the regular insert
         assert( dict.insert( 1, "AAA" ) );
@@ -281,6 +407,30 @@ int main ( void )
         assert( dict.insert( 4, "DDD" ) == false );
     }
 
+    {
+        // Testing capacity growth, reserve and shrink_to_fit.
+        DSAL<int, std::string> dict(2, 1.5);
+        std::string result;
+
+        for ( auto i(0); i < 100; ++i )
+            assert( dict.insert( 99 - i, std::to_string( 99 - i ) ) );
+        assert( dict.size() == 100 );
+        assert( dict.capacity() >= 100 );
+
+        dict.reserve( 500 );
+        assert( dict.capacity() == 500 );
+        dict.reserve( 10 );
+        assert( dict.capacity() == 500 );
+
+        dict.shrink_to_fit();
+        assert( dict.capacity() == 100 );
+        assert( dict.insert( 100, "100" ) );
+        assert( dict.capacity() == 150 );
+
+        for ( auto i(0); i <= 100; ++i )
+            assert( dict.search( i, result ) and result == std::to_string( i ) );
+    }
+
     {
         // Testing search.
         DSAL<int, std::string> dict;
@@ -481,6 +631,1031 @@ int main ( void )
         assert( key == i );
     }
 
+    {
+        // Testing sorted insert/remove with trivially copyable and non trivially copyable nodes.
+        DSAL<int, int> dict_int(100, 1.0);
+        DSAL<int, std::string> dict_str(100);
+        int keys[100];
+        for ( auto i(0); i < 100; ++i ) keys[i] = i;
+
+        std::random_device rd;
+        std::mt19937 g(rd());
+        std::shuffle( std::begin( keys ), std::end( keys ), g);
+
+        for ( const auto & k : keys )
+        {
+            assert( dict_int.insert( k, k * 10 ) );
+            assert( dict_str.insert( k, std::to_string( k ) ) );
+        }
+        assert( false == dict_int.insert( keys[0], 0 ) );
+        assert( false == dict_str.insert( keys[0], "" ) );
+        assert( false == dict_int.insert( 100, 0 ) );
+
+        // Keys must come out sorted, each one with its own data.
+        int key{ dict_str.min() }, next_key{0}, i{0};
+        int v;
+        std::string s;
+        do {
+            assert( key == i++ );
+            assert( dict_int.search( key, v ) and v == key * 10 );
+            assert( dict_str.search( key, s ) and s == std::to_string( key ) );
+        } while ( dict_str.successor( key, key ) );
+        assert( i == 100 );
+
+        // Removing from the front, the middle and the back.
+        for ( auto k : { 0, 50, 99 } )
+        {
+            assert( dict_int.remove( k, v ) and v == k * 10 );
+            assert( dict_str.remove( k, s ) and s == std::to_string( k ) );
+        }
+        assert( dict_str.min() == 1 and dict_str.max() == 98 );
+        assert( dict_str.successor( 49, next_key ) and next_key == 51 );
+        assert( dict_int.search( 51, v ) and v == 510 );
+    }
+
+    {
+        // Testing the read-optimized (Eytzinger) mode, with mutations between reads.
+        DSAL<int, std::string> dict;
+        std::string result;
+        int next_key{0};
+        dict.set_read_optimized( true );
+        assert( dict.read_optimized() );
+        assert( false == dict.search( 1, result ) );
+
+        for ( auto n(1); n <= 64; ++n )
+        {
+            // Even keys only, so odd keys are misses between two stored keys.
+            assert( dict.insert( 2 * n, std::to_string( 2 * n ) ) );
+            for ( auto k(0); k <= 2 * n + 1; ++k )
+            {
+                bool found = dict.search( k, result );
+                assert( found == ( k % 2 == 0 and k > 0 ) );
+                if ( found ) assert( result == std::to_string( k ) );
+            }
+        }
+        assert( dict.successor( 10, next_key ) and next_key == 12 );
+        assert( dict.predecessor( 10, next_key ) and next_key == 8 );
+        assert( dict.successor( 11, next_key ) and next_key == 12 );
+
+        assert( dict.remove( 10, result ) );
+        assert( false == dict.search( 10, result ) );
+        assert( dict.successor( 8, next_key ) and next_key == 12 );
+
+        dict.set_read_optimized( false );
+        assert( dict.search( 12, result ) and result == "12" );
+    }
+
+    {
+        // Testing DBT with the same scenarios used for DAL/DSAL.
+        DBT<int, std::string> dict;
+        std::string result;
+        int key, next_key{0};
+
+        assert( dict.empty() );
+        assert( false == dict.search( 1, result ) );
+        assert( false == dict.remove( 1, result ) );
+        auto worked( false );
+        try { dict.min(); } catch ( std::out_of_range & e ) { worked = true; }
+        assert( worked );
+
+        assert( dict.insert( 3, "CCC" ) );
+        assert( dict.insert( 1, "AAA" ) );
+        assert( dict.insert( 2, "BBB" ) );
+        assert( false == dict.insert( 2, "BBB" ) );
+        assert( dict.size() == 3 );
+        assert( dict.search( 2, result ) and result == "BBB" );
+        assert( dict.min() == 1 and dict.max() == 3 );
+        assert( dict.successor( 1, next_key ) and next_key == 2 );
+        assert( false == dict.successor( 3, next_key ) );
+        assert( dict.predecessor( 2, next_key ) and next_key == 1 );
+        assert( false == dict.predecessor( 1, next_key ) );
+        assert( dict.remove( 2, result ) and result == "BBB" );
+        assert( false == dict.search( 2, result ) );
+        (void) key;
+    }
+
+    {
+        // Testing DBT splits, merges and borrows against std::map, with tiny nodes to get a deep tree.
+        DBT<int, std::string, std::less<int>, 64> dict;
+        std::map<int, std::string> ref;
+        std::string result;
+        std::mt19937 g( 7 );
+        std::uniform_int_distribution<int> key_dist( 0, 2000 ), op_dist( 0, 9 );
+
+        for ( auto i(0); i < 40000; ++i )
+        {
+            auto k = key_dist( g );
+            // Inserts are more frequent at first, removals later, so the tree grows then shrinks.
+            bool do_insert = op_dist( g ) < ( i < 20000 ? 7 : 3 );
+            if ( do_insert )
+                assert( dict.insert( k, std::to_string( k ) ) == ref.insert( std::make_pair( k, std::to_string( k ) ) ).second );
+            else
+            {
+                bool removed = dict.remove( k, result );
+                assert( removed == ( ref.erase( k ) == 1 ) );
+                if ( removed ) assert( result == std::to_string( k ) );
+            }
+            assert( dict.size() == int( ref.size() ) );
+        }
+
+        for ( auto k(0); k <= 2000; ++k )
+            assert( dict.search( k, result ) == ( ref.count( k ) == 1 ) );
+
+        // The linked leaves give every key in order, forwards and backwards.
+        auto it = ref.begin();
+        int key = dict.min(), next_key;
+        do { assert( key == ( it++ )->first ); } while ( dict.successor( key, key ) );
+        assert( it == ref.end() );
+        auto rit = ref.rbegin();
+        key = dict.max();
+        do { assert( key == ( rit++ )->first ); } while ( dict.predecessor( key, key ) );
+        assert( rit == ref.rend() );
+
+        // Removing everything.
+        for ( auto & e : ref ) assert( dict.remove( e.first, result ) );
+        assert( dict.empty() );
+        assert( false == dict.successor( 0, next_key ) );
+    }
+
+    {
+        // Testing DBT bulk load.
+        for ( auto n : { 0, 1, 5, 37, 1000, 12345 } )
+        {
+            DBT<int, int, std::less<int>, 64> dict;
+            assert( dict.insert( -1, -1 ) ); // Previous content is replaced.
+            std::vector< std::pair<int, int> > sorted;
+            for ( auto i(0); i < n; ++i ) sorted.push_back( std::make_pair( 3 * i, i ) );
+            assert( dict.bulk_load( sorted.begin(), sorted.end() ) );
+            assert( dict.size() == n );
+
+            int v;
+            assert( false == dict.search( -1, v ) );
+            for ( auto i(0); i < n; ++i ) assert( dict.search( 3 * i, v ) and v == i );
+
+            // The tree must stay valid for updates after the load.
+            for ( auto i(0); i < n; ++i ) assert( dict.insert( 3 * i + 1, i ) );
+            for ( auto i(0); i < n; ++i ) assert( dict.remove( 3 * i, v ) and v == i );
+            assert( dict.size() == n );
+            if ( n > 0 ) assert( dict.min() == 1 and dict.max() == 3 * ( n - 1 ) + 1 );
+        }
+
+        // Unsorted or repeated keys are refused.
+        DBT<int, int> dict;
+        assert( dict.insert( 10, 10 ) );
+        std::vector< std::pair<int, int> > unsorted = { {1, 1}, {3, 3}, {2, 2} };
+        std::vector< std::pair<int, int> > repeated = { {1, 1}, {1, 1} };
+        assert( false == dict.bulk_load( unsorted.begin(), unsorted.end() ) );
+        assert( false == dict.bulk_load( repeated.begin(), repeated.end() ) );
+        assert( dict.size() == 1 );
+    }
+
+    {
+        // Testing DSAL ordered iterators, lower/upper bound and range queries.
+        for ( auto read_optimized : { false, true } )
+        {
+            DSAL<int, std::string> dict;
+            dict.set_read_optimized( read_optimized );
+            assert( dict.begin() == dict.end() );
+            assert( dict.range( 0, 100 ).empty() );
+
+            for ( auto i(10); i >= 1; --i ) assert( dict.insert( 10 * i, std::to_string( i ) ) );
+
+            auto expected( 10 );
+            for ( const auto & e : dict )
+            {
+                assert( e.id == expected );
+                assert( e.info == std::to_string( expected / 10 ) );
+                expected += 10;
+            }
+
+            assert( dict.lower_bound( 30 )->id == 30 );
+            assert( dict.lower_bound( 31 )->id == 40 );
+            assert( dict.lower_bound( 5 ) == dict.begin() );
+            assert( dict.lower_bound( 101 ) == dict.end() );
+            assert( dict.upper_bound( 30 )->id == 40 );
+            assert( dict.upper_bound( 29 )->id == 30 );
+            assert( dict.upper_bound( 100 ) == dict.end() );
+
+            // Bounds stored or not, inclusive on both ends.
+            auto r = dict.range( 25, 70 );
+            assert( r.size() == 5 );
+            assert( r.begin()->id == 30 and ( r.end() - 1 )->id == 70 );
+            assert( dict.range( 30, 30 ).size() == 1 );
+            assert( dict.range( 31, 39 ).empty() );
+            assert( dict.range( 70, 25 ).empty() );
+            assert( dict.range( -5, 500 ).size() == 10 );
+
+            // Zero copying: the range points into the dictionary.
+            assert( dict.range( 10, 10 ).begin() == dict.begin() );
+        }
+    }
+
+    {
+        // Testing DSAL bulk_load, sorted and unsorted input.
+        DSAL<int, std::string> dict;
+        assert( dict.insert( 1000, "old" ) );
+        std::vector< std::pair<int, std::string> > sorted, unsorted;
+        for ( auto i(0); i < 200; ++i ) sorted.push_back( std::make_pair( 2 * i, std::to_string( 2 * i ) ) );
+        assert( dict.bulk_load( sorted.begin(), sorted.end() ) );
+        assert( dict.size() == 200 );
+        std::string result;
+        assert( false == dict.search( 1000, result ) );
+        for ( auto i(0); i < 200; ++i ) assert( dict.search( 2 * i, result ) and result == std::to_string( 2 * i ) );
+
+        unsorted = { {5, "first"}, {3, "3"}, {9, "9"}, {5, "second"}, {1, "1"} };
+        assert( dict.bulk_load( unsorted.begin(), unsorted.end() ) );
+        assert( dict.size() == 4 );
+        auto expected = { 1, 3, 5, 9 };
+        assert( std::equal( expected.begin(), expected.end(), dict.begin(),
+                            []( int k, const DSAL<int, std::string>::value_type & e ) { return k == e.id; } ) );
+        assert( dict.search( 5, result ) and result == "first" ); // First occurrence wins, like insert().
+
+        // Fixed capacity too small: nothing changes.
+        DSAL<int, std::string> fixed( 3, 1.0 );
+        assert( fixed.insert( 7, "7" ) );
+        assert( false == fixed.bulk_load( sorted.begin(), sorted.end() ) );
+        assert( fixed.size() == 1 and fixed.search( 7, result ) );
+    }
+
+    {
+        // Testing DSAL merge_insert against per key insert.
+        DSAL<int, int> merged, reference;
+        for ( auto i(0); i < 300; i += 3 ) { assert( merged.insert( i, i ) ); assert( reference.insert( i, i ) ); }
+
+        // Sorted batch, some keys already stored, before, between and after the stored ones.
+        std::vector< std::pair<int, int> > batch;
+        for ( auto i(-10); i < 320; i += 5 ) batch.push_back( std::make_pair( i, -i ) );
+        assert( merged.merge_insert( batch.begin(), batch.end() ) );
+        for ( auto & p : batch ) reference.insert( p.first, p.second );
+
+        // Unsorted batch with repeated keys.
+        std::vector< std::pair<int, int> > shuffled = { {401, 1}, {-50, 2}, {401, 3}, {7, 4}, {6, 5} };
+        assert( merged.merge_insert( shuffled.begin(), shuffled.end() ) );
+        for ( auto & p : shuffled ) reference.insert( p.first, p.second );
+
+        assert( merged.size() == reference.size() );
+        assert( std::equal( merged.begin(), merged.end(), reference.begin(),
+                            []( const DSAL<int, int>::value_type & a, const DSAL<int, int>::value_type & b )
+                            { return a.id == b.id and a.info == b.info; } ) );
+
+        // Empty batch and batch with only stored keys.
+        assert( merged.merge_insert( batch.begin(), batch.begin() ) );
+        assert( merged.merge_insert( batch.begin(), batch.end() ) );
+        assert( merged.size() == reference.size() );
+
+        // Fixed capacity too small: nothing is inserted.
+        DSAL<int, int> fixed( 3, 1.0 );
+        assert( fixed.insert( 1, 1 ) );
+        assert( false == fixed.merge_insert( batch.begin(), batch.end() ) );
+        assert( fixed.size() == 1 );
+    }
+
+    {
+        // Testing the structure of arrays layout against the default one.
+        DAL<long, std::string, std::less<long>, SoA> dal;
+        DSAL<long, std::string, std::less<long>, SoA> dsal;
+        DSAL<long, std::string> aos;
+        std::string result;
+        for ( auto i(0L); i < 500; ++i )
+        {
+            long k = ( i * 7919 ) % 500 - 250; // Negative keys too, all distinct.
+            assert( dal.insert( k, std::to_string( k ) ) );
+            assert( dsal.insert( k, std::to_string( k ) ) );
+            assert( aos.insert( k, std::to_string( k ) ) );
+        }
+        assert( false == dal.insert( 17, "dup" ) );
+        assert( false == dsal.insert( 17, "dup" ) );
+
+        // Every position of the SIMD blocks and the scalar tail.
+        for ( auto k(-260L); k < 260; ++k )
+        {
+            bool stored = k >= -250 and k < 250;
+            assert( dal.search( k, result ) == stored and ( not stored or result == std::to_string( k ) ) );
+            assert( dsal.search( k, result ) == stored and ( not stored or result == std::to_string( k ) ) );
+        }
+        assert( std::equal( dsal.begin(), dsal.end(), aos.begin(),
+                            []( const DSAL<long, std::string, std::less<long>, SoA>::value_type & a,
+                                const DSAL<long, std::string>::value_type & b )
+                            { return a.id == b.id and a.info == b.info; } ) );
+
+        for ( auto k(-250L); k < 250; k += 2 )
+        {
+            assert( dal.remove( k, result ) and result == std::to_string( k ) );
+            assert( dsal.remove( k, result ) and result == std::to_string( k ) );
+        }
+        assert( dal.size() == 250 and dsal.size() == 250 );
+        assert( dal.min() == -249 and dal.max() == 249 );
+        for ( auto k(-250L); k < 250; ++k )
+        {
+            assert( dal.search( k, result ) == ( k % 2 != 0 ) );
+            assert( dsal.search( k, result ) == ( k % 2 != 0 ) );
+        }
+        long y;
+        assert( dsal.successor( -249, y ) and y == -247 );
+        dsal.set_read_optimized( true );
+        dsal.prepare_reads();
+        assert( dsal.search( 101, result ) and result == "101" );
+        assert( dsal.range( -5, 5 ).size() == 6 );
+
+        // Small keys take the 1 byte SIMD path, string keys the comparator loop.
+        DAL<char, int, std::less<char>, SoA> small;
+        for ( auto c = 'a'; c <= 'z'; ++c ) assert( small.insert( c, c - 'a' ) );
+        int pos;
+        assert( small.search( 'q', pos ) and pos == 'q' - 'a' );
+        assert( false == small.search( 'A', pos ) );
+        DAL<std::string, int, std::less<std::string>, SoA> words;
+        assert( words.insert( "one", 1 ) and words.insert( "two", 2 ) );
+        assert( words.search( "two", pos ) and pos == 2 );
+    }
+
+    {
+        // Testing min/max kept across insertions and removals, and successor/predecessor of absent keys.
+        DAL<int, int> dal;
+        DSAL<int, int> dsal;
+        DBT<int, int, std::less<int>, 64> dbt;
+        std::map<int, int> ref;
+        check_order( dal, ref, -2, 2 );
+        check_order( dsal, ref, -2, 2 );
+        check_order( dbt, ref, -2, 2 );
+
+        std::mt19937 g( 7 );
+        std::uniform_int_distribution<int> dist( 0, 60 );
+        int result;
+        for ( auto i(0); i < 400; ++i )
+        {
+            auto k = 2 * dist( g ); // Even keys, so odd ones are always absent.
+            if ( i % 3 == 2 )
+            {
+                bool stored = ref.erase( k ) == 1;
+                assert( dal.remove( k, result ) == stored );
+                assert( dsal.remove( k, result ) == stored );
+                assert( dbt.remove( k, result ) == stored );
+            }
+            else
+            {
+                bool fresh = ref.insert( std::make_pair( k, i ) ).second;
+                assert( dal.insert( k, i ) == fresh );
+                assert( dsal.insert( k, i ) == fresh );
+                assert( dbt.insert( k, i ) == fresh );
+            }
+            check_order( dal, ref, -3, 123 );
+            check_order( dsal, ref, -3, 123 );
+            check_order( dbt, ref, -3, 123 );
+        }
+
+        // Removing the bounds until empty.
+        while ( not ref.empty() )
+        {
+            auto k = ( ref.size() % 2 ) ? ref.begin()->first : ref.rbegin()->first;
+            ref.erase( k );
+            assert( dal.remove( k, result ) and dsal.remove( k, result ) );
+            check_order( dal, ref, -3, 123 );
+            check_order( dsal, ref, -3, 123 );
+        }
+        dsal.set_read_optimized( true );
+        assert( dsal.insert( 10, 1 ) and dsal.insert( 20, 2 ) );
+        int y;
+        assert( dsal.successor( 15, y ) and y == 20 and dsal.predecessor( 15, y ) and y == 10 );
+        assert( false == dsal.successor( 20, y ) and false == dsal.predecessor( 10, y ) );
+    }
+
+    {
+        // Testing DSL against std::map, single threaded.
+        DSL<int, int> dict;
+        std::map<int, int> ref;
+        int result, y;
+        bool worked = false;
+        try { dict.min(); } catch ( std::out_of_range & e ) { worked = true; }
+        assert( worked and false == dict.successor( 0, y ) and false == dict.predecessor( 0, y ) );
+
+        std::mt19937 g( 11 );
+        std::uniform_int_distribution<int> dist( 0, 300 );
+        for ( auto i(0); i < 3000; ++i )
+        {
+            auto k = 2 * dist( g );
+            if ( i % 3 == 2 )
+            {
+                auto it = ref.find( k );
+                bool stored = it != ref.end();
+                assert( dict.remove( k, result ) == stored );
+                if ( stored ) { assert( result == it->second ); ref.erase( it ); }
+            }
+            else
+            {
+                bool fresh = ref.insert( std::make_pair( k, i ) ).second;
+                assert( dict.insert( k, i ) == fresh );
+            }
+            if ( i % 100 == 0 ) dict.collect(); // Removed nodes are reused from now on.
+        }
+        assert( dict.size() == int( ref.size() ) );
+        for ( auto k(-1); k <= 602; ++k )
+            assert( dict.search( k, result ) == ( ref.count( k ) == 1 ) and ( ref.count( k ) == 0 or result == ref[k] ) );
+        check_order( dict, ref, -3, 605 );
+
+        dict.clear();
+        assert( dict.empty() and false == dict.search( ref.begin()->first, result ) );
+        assert( dict.insert( 1, 1 ) and dict.min() == 1 and dict.max() == 1 );
+    }
+
+    {
+        // Testing DSL with concurrent writers and readers. Each writer owns the keys congruent to its number.
+        DSL<int, int> dict;
+        const int writers = 4, keys = 2000;
+        std::vector< std::set<int> > owned( writers );
+        std::atomic<bool> done( false );
+        std::atomic<int> wrong( 0 );
+
+        std::vector< std::thread > threads;
+        for ( auto t(0); t < writers; ++t )
+            threads.emplace_back( [&dict, &owned, t]()
+            {
+                std::mt19937 g( t );
+                std::uniform_int_distribution<int> dist( 0, keys / writers - 1 );
+                int result;
+                for ( auto i(0); i < 20000; ++i )
+                {
+                    auto k = dist( g ) * writers + t;
+                    if ( owned[t].count( k ) ) { assert( dict.remove( k, result ) and result == 10 * k ); owned[t].erase( k ); }
+                    else { assert( dict.insert( k, 10 * k ) ); owned[t].insert( k ); }
+                }
+            } );
+        for ( auto r(0); r < 2; ++r )
+            threads.emplace_back( [&dict, &done, &wrong]()
+            {
+                int result, y;
+                while ( not done )
+                    for ( auto k(0); k < keys; ++k )
+                    {
+                        // The data of a key never changes, and keys come in order.
+                        if ( dict.search( k, result ) and result != 10 * k ) wrong++;
+                        if ( dict.successor( k, y ) and y <= k ) wrong++;
+                    }
+            } );
+        for ( auto t(0); t < writers; ++t ) threads[t].join();
+        done = true;
+        for ( auto t = writers; t < int( threads.size() ); ++t ) threads[t].join();
+
+        assert( wrong == 0 );
+        std::map<int, int> ref;
+        for ( auto & o : owned ) for ( auto k : o ) ref[k] = 10 * k;
+        assert( dict.size() == int( ref.size() ) );
+        int result;
+        for ( auto k(0); k < keys; ++k ) assert( dict.search( k, result ) == ( ref.count( k ) == 1 ) );
+        check_order( dict, ref, -1, keys );
+    }
+
+    {
+        // Testing DSL max() and predecessor() while the greatest keys are removed. A key removed before
+        // a query starts must not be its answer, even if an upper level still leads to its node.
+        DSL<int, int> dict;
+        const int keys = 20000;
+        for ( auto k(0); k < keys; ++k ) dict.insert( k, k );
+        std::atomic<int> removed( keys ); // Every key from here up was removed.
+        std::atomic<int> wrong( 0 );
+
+        std::vector< std::thread > threads;
+        threads.emplace_back( [&dict, &removed]()
+        {
+            int result;
+            for ( auto k = keys - 1; k > 0; --k ) { dict.remove( k, result ); removed = k; }
+        } );
+        for ( auto r(0); r < 2; ++r )
+            threads.emplace_back( [&dict, &removed, &wrong, keys]()
+            {
+                int y;
+                while ( removed > 1 )
+                {
+                    auto bound = removed.load();
+                    if ( dict.max() >= bound ) wrong++;
+                    if ( dict.predecessor( keys, y ) and y >= bound ) wrong++;
+                }
+            } );
+        for ( auto & t : threads ) t.join();
+
+        assert( wrong == 0 );
+        assert( dict.size() == 1 and dict.max() == 0 );
+    }
+
+    {
+        // Testing the Bloom filter: no false negatives, few false positives.
+        Bloom<int> bloom( 10000 );
+        for ( auto i(0); i < 10000; ++i ) bloom.add( 2 * i );
+        for ( auto i(0); i < 10000; ++i ) assert( bloom.may_contain( 2 * i ) );
+        auto false_positives(0);
+        for ( auto i(0); i < 10000; ++i ) false_positives += bloom.may_contain( 2 * i + 1 );
+        assert( false_positives < 300 );
+    }
+
+    {
+        // Testing DLSM against std::map, with a tiny memtable so runs are flushed and merged often.
+        DLSM<int, int> dict( 8, 3 );
+        std::map<int, int> ref;
+        int result, y;
+        bool worked = false;
+        try { dict.max(); } catch ( std::out_of_range & e ) { worked = true; }
+        assert( worked and false == dict.successor( 0, y ) );
+
+        std::mt19937 g( 13 );
+        std::uniform_int_distribution<int> dist( 0, 400 );
+        for ( auto i(0); i < 6000; ++i )
+        {
+            auto k = 2 * dist( g );
+            if ( i % 5 >= 3 ) // Removals and re-insertions of the same keys leave tombstones in several runs.
+            {
+                auto it = ref.find( k );
+                bool stored = it != ref.end();
+                assert( dict.remove( k, result ) == stored );
+                if ( stored ) { assert( result == it->second ); ref.erase( it ); }
+            }
+            else
+            {
+                bool fresh = ref.insert( std::make_pair( k, i ) ).second;
+                assert( dict.insert( k, i ) == fresh );
+            }
+            assert( dict.size() == int( ref.size() ) );
+            if ( i % 500 == 0 ) check_order( dict, ref, -3, 803 );
+        }
+        assert( dict.runs() > 1 );
+        for ( auto k(-1); k <= 802; ++k )
+            assert( dict.search( k, result ) == ( ref.count( k ) == 1 ) and ( ref.count( k ) == 0 or result == ref[k] ) );
+        check_order( dict, ref, -3, 803 );
+
+        // A single run after compaction, with the same content.
+        dict.compact();
+        assert( dict.runs() == 1 and dict.size() == int( ref.size() ) );
+        for ( auto k(-1); k <= 802; ++k ) assert( dict.search( k, result ) == ( ref.count( k ) == 1 ) );
+        check_order( dict, ref, -3, 803 );
+
+        for ( auto & e : ref ) assert( dict.remove( e.first, result ) );
+        assert( dict.empty() and false == dict.successor( -1, y ) );
+        dict.compact();
+        assert( dict.runs() == 0 ); // Every tombstone reached the oldest data.
+        assert( dict.insert( 5, 5 ) and dict.min() == 5 );
+        dict.clear();
+        assert( dict.empty() and false == dict.search( 5, result ) );
+    }
+
+    {
+        // Testing the learned index of DSAL on evenly spread, clustered and skewed keys.
+        std::mt19937_64 g( 17 );
+        std::vector< std::vector<long> > sets( 3 );
+        std::uniform_int_distribution<long> uniform( 0, 1000000000L );
+        for ( auto i(0); i < 20000; ++i ) sets[0].push_back( uniform( g ) );
+        for ( auto c(0); c < 20; ++c ) // 20 tight clusters far apart
+            for ( auto i(0); i < 1000; ++i ) sets[1].push_back( c * 100000000L + i * ( c + 1 ) );
+        for ( auto i(0); i < 60; ++i ) sets[2].push_back( 1L << i ); // Gaps doubling at every key
+        for ( auto i(0); i < 5000; ++i ) sets[2].push_back( -i * i );
+
+        for ( auto & keys : sets )
+        {
+            std::sort( keys.begin(), keys.end() );
+            keys.erase( std::unique( keys.begin(), keys.end() ), keys.end() );
+            DSAL<long, long> dict;
+            std::vector< std::pair<long, long> > pairs;
+            for ( auto k : keys ) pairs.push_back( std::make_pair( k, k / 2 ) );
+            assert( dict.bulk_load( pairs.begin(), pairs.end() ) );
+            dict.set_learned_index( true, 8 );
+            dict.prepare_reads();
+            assert( dict.learned_index() and not dict.read_optimized() );
+
+            long result, y;
+            std::uniform_int_distribution<std::size_t> pick( 0, keys.size() - 1 );
+            for ( auto i(0); i < 20000; ++i )
+            {
+                auto k = keys[ pick( g ) ] + ( i % 3 ) - 1; // Stored keys and their neighbours
+                auto lb = std::lower_bound( keys.begin(), keys.end(), k );
+                bool stored = lb != keys.end() and *lb == k;
+                assert( dict.search( k, result ) == stored and ( not stored or result == k / 2 ) );
+                assert( dict.lower_bound( k ) - dict.begin() == lb - keys.begin() );
+                assert( dict.predecessor( k, y ) == ( lb != keys.begin() ) and ( lb == keys.begin() or y == *( lb - 1 ) ) );
+            }
+            assert( false == dict.search( keys.front() - 1, result ) and false == dict.search( keys.back() + 1, result ) );
+
+            // The model is rebuilt after mutations.
+            assert( dict.remove( keys[5], result ) and false == dict.search( keys[5], result ) );
+            assert( dict.insert( keys[5], 1 ) and dict.search( keys[5], result ) and result == 1 );
+            assert( dict.search( keys[6], result ) and result == keys[6] / 2 );
+
+            dict.set_read_optimized( true );
+            assert( not dict.learned_index() and dict.search( keys[7], result ) );
+        }
+
+        // Keys that cannot be modeled use the binary search.
+        DSAL<std::string, int> words;
+        words.set_learned_index( true );
+        assert( words.insert( "b", 2 ) and words.insert( "a", 1 ) );
+        words.prepare_reads();
+        int pos;
+        assert( words.search( "a", pos ) and pos == 1 and false == words.search( "c", pos ) );
+    }
+
+    {
+        // Testing DPMA against std::map: growing, shrinking and every kind of window spread.
+        DPMA<int, int> dict;
+        std::map<int, int> ref;
+        int result, y;
+        bool worked = false;
+        try { dict.min(); } catch ( std::out_of_range & e ) { worked = true; }
+        assert( worked and false == dict.predecessor( 0, y ) and false == dict.remove( 0, result ) );
+
+        // Increasing keys fill the last segment over and over; decreasing ones, the first.
+        for ( auto i(0); i < 3000; ++i ) { assert( dict.insert( 2 * i, i ) ); ref[2 * i] = i; }
+        for ( auto i(1); i <= 3000; ++i ) { assert( dict.insert( -2 * i, i ) ); ref[-2 * i] = i; }
+        assert( false == dict.insert( 0, 0 ) );
+        check_order( dict, ref, -6003, 6003 );
+
+        std::mt19937 g( 19 );
+        std::uniform_int_distribution<int> dist( -4000, 4000 );
+        for ( auto i(0); i < 40000; ++i )
+        {
+            auto k = dist( g );
+            if ( i % 2 )
+            {
+                auto it = ref.find( k );
+                bool stored = it != ref.end();
+                assert( dict.remove( k, result ) == stored );
+                if ( stored ) { assert( result == it->second ); ref.erase( it ); }
+            }
+            else
+            {
+                bool fresh = ref.insert( std::make_pair( k, i ) ).second;
+                assert( dict.insert( k, i ) == fresh );
+            }
+        }
+        assert( dict.size() == int( ref.size() ) );
+        for ( auto k(-6001); k <= 6001; ++k )
+            assert( dict.search( k, result ) == ( ref.count( k ) == 1 ) and ( ref.count( k ) == 0 or result == ref[k] ) );
+        check_order( dict, ref, -6003, 6003 );
+
+        // Removing almost everything shrinks the array.
+        auto big = dict.capacity();
+        while ( ref.size() > 3 ) { assert( dict.remove( ref.begin()->first, result ) ); ref.erase( ref.begin() ); }
+        assert( dict.capacity() < big and dict.size() == 3 );
+        check_order( dict, ref, -6003, 6003 );
+        dict.clear();
+        assert( dict.empty() and false == dict.search( ref.begin()->first, result ) );
+
+        // Removals right after a rebuild must not rebuild again at the same capacity: each rebuild
+        // leaves the array more than a quarter full, so shrinking 8 times needs few of them.
+        for ( auto i(0); i < 1 << 14; ++i ) dict.insert( i, i );
+        auto rebuilds = dict.rebuilds();
+        for ( auto i = ( 1 << 14 ) - 1; i >= 1 << 11; --i ) assert( dict.remove( i, result ) );
+        assert( dict.rebuilds() - rebuilds <= 10 and dict.size() == 1 << 11 );
+    }
+
+    {
+        // Testing rank() and select() on DSAL and DOST, and DOST against std::map.
+        DSAL<int, int> dsal;
+        DOST<int, int> dost;
+        std::map<int, int> ref;
+        int result, y;
+        bool worked = false;
+        try { dost.max(); } catch ( std::out_of_range & e ) { worked = true; }
+        assert( worked and dost.empty() and 0 == dost.rank( 3 ) and false == dost.select( 0, y ) );
+        assert( 0 == dsal.rank( 3 ) and false == dsal.select( 0, y ) );
+
+        // Sorted insertions are the worst case for an unbalanced tree.
+        for ( auto i(0); i < 500; ++i )
+        {
+            assert( dost.insert( 3 * i, i ) and dsal.insert( 3 * i, i ) );
+            ref[3 * i] = i;
+        }
+        assert( false == dost.insert( 0, 1 ) );
+        check_rank( dsal, ref, -2, 1501 );
+        check_rank( dost, ref, -2, 1501 );
+
+        std::mt19937 g( 23 );
+        std::uniform_int_distribution<int> dist( 0, 2000 );
+        for ( auto i(0); i < 20000; ++i )
+        {
+            auto k = dist( g );
+            if ( i % 3 == 0 )
+            {
+                auto it = ref.find( k );
+                bool stored = it != ref.end();
+                assert( dost.remove( k, result ) == stored );
+                if ( stored ) { assert( result == it->second ); ref.erase( it ); }
+                dsal.remove( k, result );
+            }
+            else
+            {
+                bool fresh = ref.insert( std::make_pair( k, i ) ).second;
+                assert( dost.insert( k, i ) == fresh );
+                dsal.insert( k, i );
+            }
+        }
+        assert( dost.size() == int( ref.size() ) and dsal.size() == int( ref.size() ) );
+        for ( auto k(-1); k <= 2001; ++k )
+            assert( dost.search( k, result ) == ( ref.count( k ) == 1 ) and ( ref.count( k ) == 0 or result == ref[k] ) );
+        check_order( dost, ref, -2, 2002 );
+        check_rank( dsal, ref, -2, 2002 );
+        check_rank( dost, ref, -2, 2002 );
+
+        // Rank and select work with the read modes too.
+        dsal.set_read_optimized( true );
+        check_rank( dsal, ref, -2, 2002 );
+        dsal.set_learned_index( true, 4 );
+        check_rank( dsal, ref, -2, 2002 );
+
+        for ( auto & p : ref ) assert( dost.remove( p.first, result ) );
+        assert( dost.empty() and false == dost.remove( 0, result ) );
+        dost.insert( 1, 1 );
+        dost.clear();
+        assert( dost.empty() );
+    }
+
+    {
+        // Testing the search strategies of DSAL.
+        check_strategy< DSAL<int, int> >();
+        check_strategy< DSAL<int, int, std::less<int>, AoS, InterpolationSearch> >();
+        check_strategy< DSAL<int, int, std::less<int>, SoA, GallopingSearch> >();
+        check_strategy< DSAL<int, int, std::less<int>, AoS, AdaptiveSearch> >();
+
+        // Keys that cannot be interpolated fall back to the binary search.
+        DSAL<std::string, int, std::less<std::string>, AoS, AdaptiveSearch> words;
+        DSAL<std::string, int, std::less<std::string>, AoS, InterpolationSearch> words2;
+        int result;
+        for ( auto i(0); i < 200; ++i ) { words.insert( std::to_string( i ), i ); words2.insert( std::to_string( i ), i ); }
+        assert( words.search( "150", result ) and result == 150 and false == words.search( "1500", result ) );
+        assert( words2.search( "7", result ) and result == 7 and words2.rank( "1" ) == 1 );
+
+        // Interpolation over floating point keys, with a repeated gap.
+        DSAL<double, int, std::less<double>, AoS, InterpolationSearch> reals;
+        for ( auto i(0); i < 1000; ++i ) reals.insert( i < 500 ? i * 0.5 : 1e6 + i, i );
+        for ( auto i(0); i < 1000; ++i ) assert( reals.search( i < 500 ? i * 0.5 : 1e6 + i, result ) and result == i );
+        assert( false == reals.search( 0.25, result ) and reals.rank( 1e5 ) == 500 );
+
+        // Distinct 64 bit keys above 2^53 that round to the same double.
+        DSAL<long long, int, std::less<long long>, AoS, InterpolationSearch> big;
+        const long long base = ( 1LL << 60 ) + 1;
+        for ( auto i(0); i < 100; ++i ) big.insert( base + i, i );
+        for ( auto i(0); i < 100; ++i ) assert( big.search( base + i, result ) and result == i );
+        assert( false == big.search( base - 1, result ) and big.rank( base + 50 ) == 50 );
+    }
+
+    {
+        // Testing the copy constructors and DCOW.
+        DSAL<int, std::string, std::less<int>, SoA> orig;
+        for ( auto i(0); i < 100; ++i ) orig.insert( i, std::to_string( i ) );
+        orig.set_read_optimized( true );
+        DSAL<int, std::string, std::less<int>, SoA> copy( orig );
+        std::string text;
+        assert( copy.size() == 100 and copy.capacity() == orig.capacity() and copy.read_optimized() );
+        assert( copy.remove( 50, text ) and text == "50" and orig.search( 50, text ) and not copy.search( 50, text ) );
+        DAL<int, int> dal;
+        dal.insert( 3, 3 ); dal.insert( 1, 1 );
+        DAL<int, int> dal2( dal );
+        assert( dal2.min() == 1 and dal2.max() == 3 and dal2.size() == 2 );
+
+        DCOW<int, int> cow;
+        int result, y;
+        assert( cow.empty() and cow.insert( 5, 50 ) and false == cow.insert( 5, 0 ) );
+        auto before = cow.snapshot();
+        cow.update( []( DSAL<int, int> & d ) { for ( auto i(0); i < 10; ++i ) d.insert( i, i * 10 ); } );
+        assert( before->size() == 1 and cow.size() == 10 );
+        assert( cow.remove( 5, result ) and result == 50 and false == cow.remove( 5, result ) );
+        assert( before->search( 5, result ) and result == 50 and not cow.search( 5, result ) );
+        assert( cow.min() == 0 and cow.max() == 9 and cow.successor( 4, y ) and y == 6 and cow.predecessor( 6, y ) and y == 4 );
+        cow.clear();
+        assert( cow.empty() and before->size() == 1 );
+
+        // One writer rewrites every value in each version; readers must never see two values in one.
+        for ( auto i(0); i < 200; ++i ) cow.insert( i, 0 );
+        std::atomic<bool> done( false );
+        std::vector< std::thread > readers;
+        for ( auto t(0); t < 4; ++t )
+            readers.emplace_back( [&cow, &done]()
+            {
+                while ( not done )
+                {
+                    auto snap = cow.snapshot();
+                    int first, value;
+                    assert( snap->size() == 200 and snap->search( 0, first ) );
+                    for ( auto k(1); k < 200; ++k ) assert( snap->search( k, value ) and value == first );
+                }
+            } );
+        for ( auto v(1); v <= 300; ++v )
+            cow.update( [v]( DSAL<int, int> & d ) { int old; for ( auto k(0); k < 200; ++k ) { d.remove( k, old ); d.insert( k, v ); } } );
+        done = true;
+        for ( auto & th : readers ) th.join();
+        assert( cow.search( 199, result ) and result == 300 );
+
+        // Read-optimized versions, empty ones too, are ready before readers share them.
+        cow.clear();
+        cow.update( []( DSAL<int, int> & d ) { d.set_read_optimized( true ); } );
+        auto empty = cow.snapshot();
+        readers.clear();
+        for ( auto t(0); t < 4; ++t )
+            readers.emplace_back( [&empty]()
+            {
+                int value;
+                for ( auto k(0); k < 100; ++k ) assert( false == empty->search( k, value ) );
+            } );
+        for ( auto & th : readers ) th.join();
+        assert( empty->empty() and empty->read_optimized() );
+        cow.update( []( DSAL<int, int> & d ) { d.insert( 1, 10 ); d.set_learned_index( true ); } );
+        assert( cow.search( 1, result ) and result == 10 and not cow.search( 2, result ) );
+        assert( cow.remove( 1, result ) and cow.empty() and not cow.search( 1, result ) );
+    }
+
+    {
+        // Testing DMAP: saving a DSAL, mapping the file and reading it in place.
+        DSAL<int, int> dsal;
+        std::map<int, int> ref;
+        std::mt19937 g( 31 );
+        std::uniform_int_distribution<int> dist( -50000, 50000 );
+        for ( auto i(0); i < 20000; ++i )
+        {
+            auto k = dist( g );
+            if ( dsal.insert( k, i ) ) ref[k] = i;
+        }
+        std::string path = "/tmp/dictionary_test_" + std::to_string( getpid() ) + ".dmap";
+        using IntMap = DMAP<int, int>;
+        assert( IntMap::write( path, dsal ) );
+
+        IntMap map;
+        int result, y;
+        assert( not map.is_open() and map.empty() and false == map.search( 0, result ) and false == map.successor( 0, y ) );
+        assert( map.open( path ) and map.is_open() and map.size() == int( ref.size() ) );
+        for ( auto k(-50001); k <= 50001; ++k )
+            assert( map.search( k, result ) == ( ref.count( k ) == 1 ) and ( ref.count( k ) == 0 or result == ref[k] ) );
+        check_order( map, ref, -50002, 50002 );
+
+        // Files written with other types, truncated or of another format are refused.
+        DMAP<long, int> wide;
+        assert( false == wide.open( path ) and not wide.is_open() );
+        std::string cut_path = path + ".cut";
+        assert( IntMap::write( cut_path, dsal ) and truncate( cut_path.c_str(), 1000 ) == 0 );
+        IntMap cut;
+        assert( false == cut.open( cut_path ) and false == cut.open( "/nonexistent/file.dmap" ) );
+        assert( false == cut.open( "Makefile" ) );
+        std::remove( cut_path.c_str() );
+
+        // The mapping stays valid after the file is replaced; an empty dictionary is saved too.
+        DSAL<int, int> none;
+        assert( IntMap::write( path, none ) and map.search( ref.begin()->first, result ) );
+        check_order( map, ref, -50002, 50002 );
+        assert( cut.open( path ) and cut.empty() and false == cut.predecessor( 0, y ) );
+        bool worked = false;
+        try { cut.min(); } catch ( std::out_of_range & e ) { worked = true; }
+        assert( worked );
+        map.close();
+        assert( not map.is_open() and map.size() == 0 );
+
+        // The padding of a record is written as zeros.
+        DSAL<int, long> padded;
+        for ( auto i(0); i < 100; ++i ) padded.insert( i, -1L );
+        using LongMap = DMAP<int, long>;
+        assert( LongMap::write( path, padded ) );
+        struct Peek : LongMap { using LongMap::Header; using LongMap::Record; };
+        std::ifstream in( path, std::ios::binary );
+        std::vector<char> bytes( ( std::istreambuf_iterator<char>( in ) ), std::istreambuf_iterator<char>() );
+        in.close();
+        Peek::Header header;
+        std::memcpy( &header, bytes.data(), sizeof( header ) );
+        assert( header.count == 100 and bytes.size() == header.records + 100 * sizeof( Peek::Record ) );
+        for ( auto r(0); r < 100; ++r )
+            for ( auto b = sizeof( int ); b < offsetof( Peek::Record, info ); ++b )
+                assert( bytes[ header.records + r * sizeof( Peek::Record ) + b ] == 0 );
+
+        // Records moved off their alignment are refused, even with room for them.
+        header.records += 4;
+        std::memcpy( bytes.data(), &header, sizeof( header ) );
+        bytes.resize( bytes.size() + 64, 0 );
+        std::ofstream out( path, std::ios::binary );
+        out.write( bytes.data(), std::streamsize( bytes.size() ) );
+        out.close();
+        LongMap moved;
+        assert( false == moved.open( path ) and not moved.is_open() );
+        std::remove( path.c_str() );
+    }
+
+    {
+        // Testing DFC against std::map, with keys sharing long prefixes.
+        DFC<int, 4> dict;
+        std::map<std::string, int> ref;
+        std::string y;
+        int result;
+        bool worked = false;
+        try { dict.max(); } catch ( std::out_of_range & e ) { worked = true; }
+        assert( worked and false == dict.search( "a", result ) and false == dict.successor( "a", y ) );
+
+        std::mt19937 g( 37 );
+        std::uniform_int_distribution<int> dist( 0, 3000 );
+        auto make_key = []( int k ) { return "org/unit-" + std::to_string( k % 7 ) + "/account-" + std::to_string( k ); };
+        for ( auto i(0); i < 12000; ++i )
+        {
+            auto k = make_key( dist( g ) );
+            if ( i % 3 == 2 )
+            {
+                auto it = ref.find( k );
+                bool stored = it != ref.end();
+                assert( dict.remove( k, result ) == stored );
+                if ( stored ) { assert( result == it->second ); ref.erase( it ); }
+            }
+            else
+            {
+                bool fresh = ref.insert( std::make_pair( k, i ) ).second;
+                assert( dict.insert( k, i ) == fresh );
+            }
+        }
+        // The empty key and keys that are prefixes of others.
+        assert( dict.insert( "", -1 ) and dict.insert( "org", -2 ) and dict.insert( "org/unit-3/account-3x", -3 ) );
+        ref[""] = -1; ref["org"] = -2; ref["org/unit-3/account-3x"] = -3;
+
+        std::vector< std::string > probes;
+        for ( auto k(0); k <= 3001; ++k ) probes.push_back( make_key( k ) );
+        probes.push_back( "" ); probes.push_back( "o" ); probes.push_back( "org/" ); probes.push_back( "zzz" );
+        assert( dict.size() == int( ref.size() ) and dict.min() == "" and dict.max() == ref.rbegin()->first );
+        for ( auto & k : probes )
+        {
+            auto it = ref.find( k );
+            assert( dict.search( k, result ) == ( it != ref.end() ) and ( it == ref.end() or result == it->second ) );
+            auto above = ref.upper_bound( k );
+            assert( dict.successor( k, y ) == ( above != ref.end() ) and ( above == ref.end() or y == above->first ) );
+            auto below = ref.lower_bound( k );
+            assert( dict.predecessor( k, y ) == ( below != ref.begin() ) and ( below == ref.begin() or y == ( --below )->first ) );
+        }
+
+        // Bulk loading, unsorted and with a repeated key, and removing everything.
+        std::vector< std::pair< std::string, int > > pairs = { { "b", 2 }, { "a", 1 }, { "ab", 3 }, { "b", 4 } };
+        dict.bulk_load( pairs.begin(), pairs.end() );
+        assert( dict.size() == 3 and dict.search( "b", result ) and result == 2 and dict.successor( "a", y ) and y == "ab" );
+        assert( dict.remove( "a", result ) and dict.remove( "ab", result ) and dict.remove( "b", result ) and dict.empty() );
+        assert( dict.insert( "c", 5 ) and dict.min() == "c" and dict.max() == "c" );
+        dict.clear();
+        assert( dict.empty() and false == dict.predecessor( "d", y ) );
+
+        // A small last block is merged with the previous one.
+        struct Blocks : DFC<int, 4> { int blocks( void ) const { return int( mv_Blocks.size() ); } };
+        Blocks few;
+        std::vector< std::pair< std::string, int > > twelve;
+        for ( auto i(0); i < 12; ++i ) twelve.push_back( std::make_pair( std::string( 1, char( 'a' + i ) ), i ) );
+        few.bulk_load( twelve.begin(), twelve.end() );
+        assert( few.blocks() == 3 );
+        assert( few.remove( "l", result ) and few.remove( "k", result ) and few.blocks() == 3 );
+        assert( few.remove( "j", result ) and result == 9 and few.blocks() == 2 and few.size() == 9 );
+        assert( few.max() == "i" and few.search( "e", result ) and result == 4 and false == few.search( "j", result ) );
+    }
+
+    {
+        // Testing DHAL against a std::map, with a good hash and with one that collides a lot.
+        struct Clustered { std::size_t operator()( int _k ) const { return std::size_t( _k % 4 ); } };
+        DHAL<int, int> dict;
+        DHAL<int, int, std::less<int>, Clustered, SoA> clustered( 2 );
+        std::map<int, int> ref;
+        int result;
+        assert( false == dict.search( 1, result ) and false == dict.remove( 1, result ) );
+
+        std::mt19937 g( 45 );
+        std::uniform_int_distribution<int> dist( -500, 500 );
+        for ( auto i(0); i < 20000; ++i )
+        {
+            auto k = dist( g );
+            if ( i % 5 < 2 )
+            {
+                auto it = ref.find( k );
+                bool stored = it != ref.end();
+                assert( dict.remove( k, result ) == stored and ( not stored or result == it->second ) );
+                assert( clustered.remove( k, result ) == stored and ( not stored or result == it->second ) );
+                if ( stored ) ref.erase( it );
+            }
+            else
+            {
+                bool fresh = ref.insert( std::make_pair( k, i ) ).second;
+                assert( dict.insert( k, i ) == fresh and clustered.insert( k, i ) == fresh );
+            }
+            // Every key must still be found after the last element moved to the gap
+            if ( i % 1000 == 999 )
+            {
+                for ( auto j(-501); j <= 501; ++j )
+                {
+                    auto it = ref.find( j );
+                    assert( dict.search( j, result ) == ( it != ref.end() ) and ( it == ref.end() or result == it->second ) );
+                    assert( clustered.search( j, result ) == ( it != ref.end() ) and ( it == ref.end() or result == it->second ) );
+                }
+                assert( dict.size() == int( ref.size() ) and clustered.size() == int( ref.size() ) );
+                check_order( dict, ref, -502, 502 );
+            }
+        }
+
+        // Emptying it and filling it again.
+        for ( auto & e : ref ) assert( dict.remove( e.first, result ) and result == e.second );
+        assert( dict.empty() and false == dict.search( ref.begin()->first, result ) );
+        for ( auto & e : ref ) assert( dict.insert( e.first, e.second ) );
+        check_order( dict, ref, -502, 502 );
+
+        // A copy keeps its own table.
+        DHAL<int, int> copy( dict );
+        assert( copy.remove( ref.begin()->first, result ) and dict.search( ref.begin()->first, result ) );
+
+        // Fixed capacity: a full dictionary refuses new keys and keeps its table consistent.
+        DHAL<int, int> fixed( 3, 1.0 );
+        assert( fixed.insert( 1, 1 ) and fixed.insert( 2, 2 ) and fixed.insert( 3, 3 ) );
+        assert( false == fixed.insert( 4, 4 ) and false == fixed.search( 4, result ) );
+        assert( fixed.remove( 1, result ) and fixed.insert( 4, 4 ) and fixed.search( 3, result ) and result == 3 );
+    }
+
     std::cout << ">>> Passed the unit tests successfully!\n";
     return EXIT_SUCCESS;
 }
\ No newline at end of file
@@ -0,0 +1,381 @@
+/**
+ * @file    suite_dictionary.cpp
+ * @brief   Standard workloads run over the dictionaries, with results in
+ *          CSV or JSON for tracking regressions between versions.
+ */
+
+#include <iostream>
+#include <chrono>
+#include <cstdlib>
+#include <cstdio>     // std::snprintf
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>     // std::unique_ptr
+#include <random>
+#include <algorithm>
+#include <utility>
+#include <stdexcept>  // std::invalid_argument
+
+#include <type_traits> // std::true_type, std::false_type
+
+#include "dal.h"
+#include "dhal.h"
+#include "dsal.h"
+#include "dbt.h"
+#include "dsl.h"
+#include "dlsm.h"
+#include "dpma.h"
+#include "dost.h"
+#include "dcow.h"
+#include "dfc.h"
+
+using namespace ac;
+
+/**
+ * @brief      std::map behind the interface of the dictionaries, as the
+ *             reference every structure is compared against.
+ */
+template< typename Key, typename Data >
+class StdMap
+{
+    public:
+
+        StdMap ( int = 0 ) { /* empty */ }
+
+        bool insert ( const Key & _newKey, const Data & _newInfo )
+        {
+            return m_Map.insert( std::make_pair( _newKey, _newInfo ) ).second;
+        }
+
+        bool remove ( const Key & _x, Data & _s )
+        {
+            auto it = m_Map.find( _x );
+            if ( it == m_Map.end() ) return false;
+            _s = it->second;
+            m_Map.erase( it );
+            return true;
+        }
+
+        bool search ( const Key & _x, Data & _s ) const
+        {
+            auto it = m_Map.find( _x );
+            if ( it == m_Map.end() ) return false;
+            _s = it->second;
+            return true;
+        }
+
+        bool successor ( const Key & _x, Key & _y ) const
+        {
+            auto it = m_Map.upper_bound( _x );
+            if ( it == m_Map.end() ) return false;
+            _y = it->first;
+            return true;
+        }
+
+        Key min ( void ) const { return m_Map.begin()->first; }
+        int size ( void ) const { return int( m_Map.size() ); }
+
+    private:
+
+        std::map< Key, Data > m_Map;
+};
+
+/**
+ * @brief      Keys and values of the workloads. Key i is the i-th smallest
+ *             one for every type: strings are zero padded.
+ */
+template< typename T > T make_value ( long _i ) { return T( _i ); }
+template<> std::string make_value< std::string > ( long _i )
+{
+    char buffer[32];
+    std::snprintf( buffer, sizeof( buffer ), "key-%012ld", _i );
+    return buffer;
+}
+
+/**
+ * @brief      Structures that take their capacity on construction: the
+ *             arrays. The others start empty and grow.
+ */
+template< typename Dict > struct Presized : std::false_type {};
+template< typename Key, typename Data > struct Presized< DAL< Key, Data > > : std::true_type {};
+template< typename Key, typename Data > struct Presized< DHAL< Key, Data > > : std::true_type {};
+template< typename Key, typename Data > struct Presized< DSAL< Key, Data > > : std::true_type {};
+
+template< typename Dict > Dict * create ( long _n, std::true_type ) { return new Dict( int( _n ) ); }
+template< typename Dict > Dict * create ( long, std::false_type ) { return new Dict(); }
+
+/**
+ * @brief      Creates an empty dictionary for n pairs.
+ */
+template< typename Dict > Dict * create ( long _n ) { return create< Dict >( _n, Presized< Dict >() ); }
+
+/**
+ * @brief      Loading the dictionary from unsorted pairs: DSAL and DFC
+ *             sort them once, DCOW does it in a single version, the others
+ *             insert one by one.
+ */
+template< typename Dict, typename Pairs >
+void load ( Dict & _dict, const Pairs & _pairs )
+{
+    for ( auto & p : _pairs ) _dict.insert( p.first, p.second );
+}
+
+template< typename Key, typename Data, typename Pairs >
+void load ( DSAL< Key, Data > & _dict, const Pairs & _pairs )
+{
+    _dict.bulk_load( _pairs.begin(), _pairs.end() );
+}
+
+template< typename Data, typename Pairs >
+void load ( DFC< Data > & _dict, const Pairs & _pairs )
+{
+    _dict.bulk_load( _pairs.begin(), _pairs.end() );
+}
+
+template< typename Key, typename Data, typename Pairs >
+void load ( DCOW< Key, Data > & _dict, const Pairs & _pairs )
+{
+    _dict.update( [&]( DSAL< Key, Data > & _d ) { _d.bulk_load( _pairs.begin(), _pairs.end() ); } );
+}
+
+/**
+ * @brief      Settings of a run of the suite, from the command line.
+ */
+struct Config
+{
+    long max_n;         //!< Largest input size, from 1e3 by powers of 10.
+    long max_linear;    //!< Largest input size for the structures that are linear per operation.
+    long ops;           //!< Operations timed per workload (at most n).
+    long ops_linear;    //!< Operations timed per workload on the linear structures.
+    int runs;           //!< Repetitions of each workload.
+    bool json;          //!< JSON instead of CSV.
+    std::string key;    //!< Name of the key type.
+    std::string data;   //!< Name of the value type.
+};
+
+/**
+ * @brief      Prints the results, one line (CSV) or object (JSON) per
+ *             workload, as soon as each one is done.
+ */
+class Reporter
+{
+    public:
+
+        Reporter ( const Config & _cfg ) : m_Cfg( _cfg ), mb_First( true )
+        {
+            if ( m_Cfg.json ) std::cout << "[" << std::endl;
+            else std::cout << "structure,workload,key,data,n,ops,runs,mean_ms,min_ms,ns_per_op" << std::endl;
+        }
+
+        ~Reporter ( void )
+        {
+            if ( m_Cfg.json ) std::cout << ( mb_First ? "" : "\n" ) << "]" << std::endl;
+        }
+
+        void operator() ( const std::string & _structure, const std::string & _workload,
+                          long _n, long _ops, const std::vector< double > & _times )
+        {
+            if ( _times.empty() ) throw std::invalid_argument( "Cannot report a workload with no runs." );
+            double mean = 0.0, min = _times.front();
+            for ( auto t : _times ) { mean += t / _times.size(); min = std::min( min, t ); }
+            double ns_per_op = mean * 1e6 / _ops;
+
+            if ( m_Cfg.json )
+            {
+                std::cout << ( mb_First ? "" : ",\n" )
+                          << "  {\"structure\": \"" << _structure << "\", \"workload\": \"" << _workload
+                          << "\", \"key\": \"" << m_Cfg.key << "\", \"data\": \"" << m_Cfg.data
+                          << "\", \"n\": " << _n << ", \"ops\": " << _ops << ", \"runs\": " << _times.size()
+                          << ", \"mean_ms\": " << mean << ", \"min_ms\": " << min
+                          << ", \"ns_per_op\": " << ns_per_op << "}";
+            }
+            else
+            {
+                std::cout << _structure << "," << _workload << "," << m_Cfg.key << "," << m_Cfg.data << ","
+                          << _n << "," << _ops << "," << _times.size() << ","
+                          << mean << "," << min << "," << ns_per_op << std::endl;
+            }
+            mb_First = false;
+        }
+
+    private:
+
+        const Config & m_Cfg;
+        bool mb_First;
+};
+
+/**
+ * @brief      Times f once per run, calling setup (not timed) before each.
+ *
+ * @return     The time of each run, in milliseconds.
+ */
+template< typename Setup, typename Func >
+std::vector< double > measure ( int runs, Setup setup, Func f )
+{
+    std::vector< double > times;
+    for ( int k = 0; k < runs; ++k )
+    {
+        setup();
+        auto start = std::chrono::steady_clock::now();
+        f();
+        auto end = std::chrono::steady_clock::now();
+        times.push_back( std::chrono::duration< double, std::milli >( end - start ).count() );
+    }
+    return times;
+}
+
+/**
+ * @brief      Runs every workload on one structure and input size. The
+ *             dictionary holds the keys 0, 2, ..., 2n - 2, so odd keys are
+ *             misses.
+ *
+ *             - bulk load: n pairs in random order into an empty dictionary;
+ *             - search hit / 50% miss / miss: random keys;
+ *             - sequential search: stored keys in increasing order;
+ *             - churn: removing a stored key and inserting an absent one,
+ *               so the size stays n, as many times as the operations
+ *               timed on the linear structures;
+ *             - successor scan: walking up from the minimum.
+ *
+ * @tparam     Dict  Dictionary with the interface of DAL.
+ */
+template< typename Dict, typename Key, typename Data >
+void run_workloads ( const std::string & name, long n, long ops, const Config & cfg, Reporter & report )
+{
+    ops = std::min( ops, n );
+    std::mt19937 g( 42 );
+    std::vector< std::pair< Key, Data > > pairs;
+    for ( long i = 0; i < n; ++i ) pairs.push_back( std::make_pair( make_value< Key >( 2 * i ), make_value< Data >( i ) ) );
+    std::shuffle( pairs.begin(), pairs.end(), g );
+
+    std::uniform_int_distribution< long > pick( 0, n - 1 );
+    std::vector< Key > hits, halves, misses, sequential, added;
+    for ( long i = 0; i < ops; ++i )
+    {
+        hits.push_back( make_value< Key >( 2 * pick( g ) ) );
+        halves.push_back( make_value< Key >( 2 * pick( g ) + i % 2 ) );
+        misses.push_back( make_value< Key >( 2 * pick( g ) + 1 ) );
+        sequential.push_back( make_value< Key >( 2 * ( i * n / ops ) ) );
+        added.push_back( make_value< Key >( 2 * i + 1 ) );
+    }
+
+    std::unique_ptr< Dict > stored( create< Dict >( n ) );
+    Dict & dict = *stored;
+    load( dict, pairs );
+    long sink = 0;
+    Data data;
+    Key y;
+
+    // A scratch dictionary for the workloads that change it
+    std::unique_ptr< Dict > fresh;
+    report( name, "bulk load", n, n, measure( cfg.runs, [&]() { fresh.reset( create< Dict >( n ) ); },
+                                             [&]() { load( *fresh, pairs ); } ) );
+
+    auto search = [&]( const std::string & _workload, const std::vector< Key > & _keys )
+    {
+        report( name, _workload, n, ops, measure( cfg.runs, [](){},
+                                                  [&]() { for ( auto & k : _keys ) sink += dict.search( k, data ); } ) );
+    };
+    search( "search hit", hits );
+    search( "search 50% miss", halves );
+    search( "search miss", misses );
+    search( "sequential search", sequential );
+
+    report( name, "successor scan", n, ops, measure( cfg.runs, [](){}, [&]()
+    {
+        Key k = dict.min();
+        long steps = 0;
+        while ( steps < ops and dict.successor( k, y ) ) { k = y; ++steps; }
+        sink += steps;
+    } ) );
+
+    // Insertions and removals move half of the array of DAL and DSAL on average
+    long churn = std::min( cfg.ops_linear, n );
+    report( name, "insert/remove churn", n, 2 * churn, measure( cfg.runs, [&]() { fresh.reset( create< Dict >( n ) ); load( *fresh, pairs ); }, [&]()
+    {
+        for ( long i = 0; i < churn; ++i )
+        {
+            sink += fresh->remove( hits[i], data );
+            sink += fresh->insert( added[i], data );
+        }
+    } ) );
+
+    if ( sink == 42 ) std::cerr << "";
+}
+
+/**
+ * @brief      DFC only takes std::string keys.
+ */
+template< typename Key, typename Data >
+void run_strings ( long, const Config &, Reporter &, std::false_type ) { /* empty */ }
+
+template< typename Key, typename Data >
+void run_strings ( long n, const Config & cfg, Reporter & report, std::true_type )
+{
+    run_workloads< DFC< Data >, Key, Data >( "DFC", n, cfg.ops, cfg, report );
+}
+
+/**
+ * @brief      Runs the suite for one key and value type. A new structure
+ *             only needs one more line here. DMAP is left out: it is read
+ *             only, loaded from a file.
+ */
+template< typename Key, typename Data >
+void run_suite ( const Config & cfg )
+{
+    Reporter report( cfg );
+    for ( long n = 1000; n <= cfg.max_n; n *= 10 )
+    {
+        if ( n <= cfg.max_linear )
+        {
+            run_workloads< DAL< Key, Data >, Key, Data >( "DAL", n, cfg.ops_linear, cfg, report );
+            // Hashed searches, but successor() still scans the array
+            run_workloads< DHAL< Key, Data >, Key, Data >( "DHAL", n, cfg.ops_linear, cfg, report );
+            // Every change copies the whole dictionary
+            run_workloads< DCOW< Key, Data >, Key, Data >( "DCOW", n, cfg.ops, cfg, report );
+        }
+        run_workloads< DSAL< Key, Data >, Key, Data >( "DSAL", n, cfg.ops, cfg, report );
+        run_workloads< DBT< Key, Data >, Key, Data >( "DBT", n, cfg.ops, cfg, report );
+        run_workloads< DSL< Key, Data >, Key, Data >( "DSL", n, cfg.ops, cfg, report );
+        run_workloads< DLSM< Key, Data >, Key, Data >( "DLSM", n, cfg.ops, cfg, report );
+        run_workloads< DPMA< Key, Data >, Key, Data >( "DPMA", n, cfg.ops, cfg, report );
+        run_workloads< DOST< Key, Data >, Key, Data >( "DOST", n, cfg.ops, cfg, report );
+        run_strings< Key, Data >( n, cfg, report, std::is_same< Key, std::string >() );
+        run_workloads< StdMap< Key, Data >, Key, Data >( "std::map", n, cfg.ops, cfg, report );
+    }
+}
+
+template< typename Key >
+void run_data ( const Config & cfg )
+{
+    if ( cfg.data == "long" ) run_suite< Key, long >( cfg );
+    else run_suite< Key, std::string >( cfg );
+}
+
+int main( int argc, char const **argv )
+{
+    Config cfg;
+    cfg.max_n = argc > 1 ? std::atol( argv[1] ) : 10000000;
+    cfg.max_linear = argc > 2 ? std::atol( argv[2] ) : 100000;
+    cfg.runs = argc > 3 ? std::atoi( argv[3] ) : 3;
+    cfg.json = argc > 4 and std::string( argv[4] ) == "json";
+    cfg.key = argc > 5 ? argv[5] : "long";
+    cfg.data = argc > 6 ? argv[6] : "long";
+    cfg.ops = 1000000;
+    cfg.ops_linear = 1000;
+
+    // Checked before anything runs
+    bool known_key = cfg.key == "int" or cfg.key == "long" or cfg.key == "string";
+    bool known_data = cfg.data == "long" or cfg.data == "string";
+    if ( not known_key or not known_data or cfg.max_n < 1 or cfg.max_linear < 1 or cfg.runs < 1 )
+    {
+        std::cerr << "Usage: " << argv[0] << " [max size] [max DAL size] [runs] [csv|json] [int|long|string key] [long|string data]\n";
+        return EXIT_FAILURE;
+    }
+
+    if ( cfg.key == "int" ) run_data< int >( cfg );
+    else if ( cfg.key == "long" ) run_data< long >( cfg );
+    else run_data< std::string >( cfg );
+    return EXIT_SUCCESS;
+}
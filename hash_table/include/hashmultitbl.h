@@ -0,0 +1,302 @@
+/**
+ * @file    hashmultitbl.h
+ * @brief   Defining and implementing functions for ADT Hash Table with
+ *          multiple values per key.
+ */
+
+#ifndef _HASHMULTITBL_H_
+#define _HASHMULTITBL_H_
+
+#include <forward_list>
+#include <vector>
+#include <functional>
+#include <utility> // std::pair, std::move
+
+#include "prime.h"
+
+namespace ac
+{
+	template< class KeyType, class DataType >
+	class HashMultiEntry
+	{
+		public:
+			HashMultiEntry ( KeyType k_, DataType d_ ) : m_key( k_ ), m_values( 1, d_ )
+			{ /* empty */ }
+			KeyType m_key; //!< Stores the key for an entry.
+			std::vector< DataType > m_values; //!< Stores, contiguously, every value of the key.
+	};
+
+	/**
+	 * @brief      Hash table where a key may hold several values. Instead of
+	 *             one list node per value, each key has a single node whose
+	 *             values are kept side by side in a vector.
+	 *
+	 * @tparam     KeyType   Key of the element.
+	 * @tparam     DataType  Value associated to the key.
+	 * @tparam     KeyHash   Functor to hash the key.
+	 * @tparam     KeyEqual  Functor to compare keys.
+	 */
+	template < typename KeyType,
+			   typename DataType,
+			   typename KeyHash = std::hash<KeyType>,
+			   typename KeyEqual = std::equal_to<KeyType> >
+
+	class HashMultiTbl
+	{
+		private:
+
+			/**
+			 * @brief      Finds the node holding a key.
+			 *
+			 * @param[in]  k_    Key to be found.
+			 *
+			 * @return     Pointer to the node or nullptr if the key is not on
+			 *             the table.
+			 */
+			const HashMultiEntry< KeyType, DataType > * find_entry ( const KeyType & k_ ) const
+			{
+				KeyHash hashFunc;
+				KeyEqual equalFunc;
+				auto end( hashFunc( k_ ) % m_size );
+				for(auto i = m_data_table[end].begin(); i != m_data_table[end].end(); ++i)
+				{
+					if( equalFunc( i -> m_key, k_ ) ) return &(*i);
+				}
+				return nullptr;
+			}
+
+		public:
+
+			using Entry = HashMultiEntry< KeyType, DataType >; //!< Alias
+			using const_iterator = const DataType *; //!< Iterator over the values of one key.
+
+			/**
+			 * @brief      Default constructor. Initializes attributes and sets
+			 *             the m_size with the prime number closest to the
+			 *             clients input (if provided any).
+			 *
+			 * @param[in]  tbl_size_  The table size.
+			 */
+			HashMultiTbl ( int tbl_size_ = DEFAULT_SIZE )
+				: m_keys(0)
+				, m_count(0)
+			{
+				m_size = find_Next_Prime(tbl_size_);
+				m_data_table = new std::forward_list<Entry>[m_size];
+			}
+
+			/**
+			 * @brief      Default destructor. Clears all elements of this table
+			 *             and deletes m_data_table.
+			 */
+			virtual ~HashMultiTbl() { clear(); delete [] m_data_table; }
+
+			/**
+			 * @brief      The table owns its buckets, so it cannot be copied.
+			 */
+			HashMultiTbl ( const HashMultiTbl & ) = delete;
+			HashMultiTbl & operator= ( const HashMultiTbl & ) = delete;
+
+			/**
+			 * @brief      Appends a value to the ones already stored under a
+			 *             key. Values of the same key keep their insertion
+			 *             order.
+			 *
+			 * @param[in]  k_    The key of the element.
+			 * @param[in]  d_    The data of the element.
+			 *
+			 * @return     True if the key was not on the table before. False
+			 *             if the value was appended to an existing key.
+			 */
+			bool insert ( const KeyType & k_, const DataType & d_ )
+			{
+				// The load factor counts keys, since each key is a single node.
+				if ( m_keys == m_size ) rehash();
+				KeyHash hashFunc;
+				KeyEqual equalFunc;
+				auto end( hashFunc( k_ ) % m_size );
+				m_count++;
+				for(auto i = m_data_table[end].begin(); i != m_data_table[end].end(); ++i)
+				{
+					if( equalFunc( i -> m_key, k_ ) )
+					{
+						i -> m_values.push_back( d_ );
+						return false;
+					}
+				}
+				m_data_table[end].emplace_front( k_, d_ );
+				m_keys++;
+				return true;
+			}
+
+			/**
+			 * @brief      Adds delta_ to the last value stored under k_,
+			 *             creating the key with delta_ as its only value if it
+			 *             is not on the table yet. Like HashTbl::increment(),
+			 *             the key is hashed only once and its list is walked a
+			 *             single time.
+			 *
+			 * @param[in]  k_      The key of the element.
+			 * @param[in]  delta_  Amount to be added. Provided none, default
+			 *                     value is 1.
+			 *
+			 * @return     True if a new key was created. False if an existing
+			 *             value was updated.
+			 */
+			bool increment ( const KeyType & k_, const DataType & delta_ = DataType(1) )
+			{
+				if ( m_keys == m_size ) rehash();
+				KeyHash hashFunc;
+				KeyEqual equalFunc;
+				auto end( hashFunc( k_ ) % m_size );
+				for(auto i = m_data_table[end].begin(); i != m_data_table[end].end(); ++i)
+				{
+					if( equalFunc( i -> m_key, k_ ) )
+					{
+						i -> m_values.back() += delta_;
+						return false;
+					}
+				}
+				m_data_table[end].emplace_front( k_, delta_ );
+				m_keys++;
+				m_count++;
+				return true;
+			}
+
+			/**
+			 * @brief      Removes a key and every value associated to it.
+			 *
+			 * @param[in]  k_    Key of the elements to be removed.
+			 *
+			 * @return     True if the key was found. False, otherwise.
+			 */
+			bool remove ( const KeyType & k_ )
+			{
+				KeyHash hashFunc;
+				KeyEqual equalFunc;
+				auto end( hashFunc( k_ ) % m_size );
+				auto before = m_data_table[end].before_begin();
+				for(auto i = m_data_table[end].begin(); i != m_data_table[end].end(); ++i, ++before)
+				{
+					if( equalFunc( i -> m_key, k_ ) )
+					{
+						m_count -= i -> m_values.size();
+						m_data_table[end].erase_after(before);
+						m_keys--;
+						return true;
+					}
+				}
+				return false;
+			}
+
+			/**
+			 * @brief      Retrieves the range of values stored under a key.
+			 *             The range is contiguous and stays valid until the
+			 *             next modification of that key.
+			 *
+			 * @param[in]  k_    Key of the elements to be retrieved.
+			 *
+			 * @return     Pair [first, last) of pointers to the values. Both
+			 *             are nullptr if the key is not on the table.
+			 */
+			std::pair< const_iterator, const_iterator > equal_range ( const KeyType & k_ ) const
+			{
+				auto e = find_entry( k_ );
+				if ( e == nullptr ) return std::make_pair( const_iterator(nullptr), const_iterator(nullptr) );
+				auto first = e -> m_values.data();
+				return std::make_pair( first, first + e -> m_values.size() );
+			}
+
+			/**
+			 * @brief      Retrieves how many values are stored under a key.
+			 *
+			 * @param[in]  k_    Key to be checked.
+			 *
+			 * @return     Number of values of the key. 0 if not found.
+			 */
+			unsigned long int count ( const KeyType & k_ ) const
+			{
+				auto e = find_entry( k_ );
+				return e == nullptr ? 0 : e -> m_values.size();
+			}
+
+			/**
+			 * @brief      This function iterates over each forward_list of the
+			 *             table and calls for their method clear().
+			 */
+			void clear ( void )
+			{
+				for( auto i(0u); i < m_size; ++i ) m_data_table[i].clear();
+				m_keys = 0;
+				m_count = 0;
+			}
+
+			/**
+			 * @brief      Checks if the table is empty or not.
+			 *
+			 * @return     True if it is, false otherwise.
+			 */
+			bool empty ( void ) const
+			{
+				return m_count == 0;
+			}
+
+			/**
+			 * @brief      This function retrieves for the client how many
+			 *             values are stored within this table.
+			 *
+			 * @return     Number of values stored in this table.
+			 */
+			unsigned long int count ( void ) const
+			{
+				return m_count;
+			}
+
+			/**
+			 * @brief      This function retrieves for the client how many
+			 *             distinct keys are stored within this table.
+			 *
+			 * @return     Number of keys stored in this table.
+			 */
+			unsigned long int key_count ( void ) const
+			{
+				return m_keys;
+			}
+
+		private:
+
+			/**
+			 * @brief      Creates a table with the next prime closest to the
+			 *             double of the current size and moves every node to
+			 *             it. The values of a key are moved along with it, not
+			 *             copied.
+			 */
+			void rehash( void )
+			{
+				KeyHash hashFunc;
+				auto n_size = find_Next_Prime(m_size * 2);
+				auto n_table = new std::forward_list<Entry> [n_size];
+				for(auto i(0u); i != m_size; ++i)
+				{
+					for(auto j = m_data_table[i].begin(); j != m_data_table[i].end(); ++j)
+					{
+						auto n_end ( hashFunc( j -> m_key ) % n_size );
+						n_table[n_end].push_front( std::move(*j) );
+					}
+				}
+
+				delete [] m_data_table;
+				m_data_table = n_table;
+				m_size = n_size;
+			}
+
+		private:
+			unsigned int m_keys; //!< Number of distinct keys currently stored in the table.
+			unsigned long int m_count; //!< Number of values currently stored in the table.
+			unsigned int m_size; //!< Hash table size.
+			std::forward_list < Entry > * m_data_table;
+			static const short DEFAULT_SIZE = 11; //!< Default size for this hash table.
+	};
+}
+
+#endif
@@ -12,7 +12,13 @@
 #include <forward_list>
 #include <iostream>
 #include <functional>
-#include <cmath> // std::sqrt
+#include <utility> // std::move, std::pair
+#include <algorithm> // std::max
+#include <iterator> // std::distance, std::advance
+#include <vector>
+#include <thread>
+
+#include "prime.h"
 
 namespace ac
 {
@@ -33,40 +39,6 @@ namespace ac
 
 	class HashTbl
 	{
-		private:
-			
-			/**
-			 * @brief      Helper function to check if a size is prime or not.
-			 *
-			 * @param[in]  size  Size to be checked.
-			 *
-			 * @return     True if size is prime. False, otherwise.
-			 */
-			bool check_Prime ( unsigned int size ) 
-			{
-				int i;
-				if(size == 0 || size == 1) return false;
-			    for(i = 2; i <= std::sqrt(size); ++i)
-			    {
-			        if ( size%i == 0 ) return false;
-			    }
-			  	return true;
-			}
-
-			/**
-			 * @brief      Helper function to find the next prime number of a
-			 *             given size.
-			 *
-			 * @param[in]  size  Initial number to find next prime.
-			 *
-			 * @return     The closest prime number of the given size.
-			 */
-			unsigned int find_Next_Prime( unsigned int size )
-			{
-				while( not check_Prime(size) ) size++;
-				return size;
-			}
-
 		public:
 			
 			using Entry = HashEntry< KeyType, DataType >; //!< Alias
@@ -128,6 +100,137 @@ namespace ac
 				return true;
 			}
 
+			/**
+			 * @brief      Inserts every pair of the range [first, last) in this
+			 *             table, with the same semantics of calling insert()
+			 *             for each one of them in order. The table is resized
+			 *             only once, up front, and the work is split among
+			 *             threads_ threads: first, each thread hashes a slice
+			 *             of the input and distributes it by bucket range;
+			 *             then, each thread inserts the pairs of its own range
+			 *             of buckets. Since the ranges are disjoint, no locks
+			 *             are needed.
+			 *
+			 * @param[in]  first     Where the range begins.
+			 * @param[in]  last      Where the range ends.
+			 * @param[in]  threads_  Number of threads. Provided none, uses the
+			 *                       number of hardware threads.
+			 *
+			 * @tparam     InputItr  Forward iterator to std::pair<KeyType, DataType>.
+			 *
+			 * @return     Number of new keys inserted.
+			 */
+			template< typename InputItr >
+			unsigned long int bulk_build ( InputItr first, InputItr last,
+										   unsigned int threads_ = std::thread::hardware_concurrency() )
+			{
+				auto n = static_cast< unsigned long int >( std::distance( first, last ) );
+				if ( n == 0 ) return 0;
+				if ( threads_ == 0 ) threads_ = 1;
+				if ( threads_ > n ) threads_ = n;
+
+				// Resizes once, so the load factor stays below 1.0 after the build.
+				if ( m_count + n >= m_size ) rehash( m_count + n + 1 );
+
+				// Pairs of (bucket, element) that each thread sends to each range of buckets.
+				using Bucketed = std::pair< unsigned int, InputItr >;
+				std::vector< std::vector< std::vector< Bucketed > > > parts( threads_,
+					std::vector< std::vector< Bucketed > >( threads_ ) );
+				std::vector< unsigned long int > inserted( threads_, 0 );
+				std::vector< std::thread > workers;
+				auto table_size = m_size;
+
+				// Phase 1: hashing a slice of the input and distributing it by bucket range.
+				auto slice_begin = first;
+				for ( auto t(0u); t != threads_; ++t )
+				{
+					auto slice_end = slice_begin;
+					std::advance( slice_end, n / threads_ + ( t < n % threads_ ? 1 : 0 ) );
+					workers.emplace_back( [&parts, table_size, threads_, t]( InputItr b, InputItr e )
+					{
+						KeyHash hashFunc;
+						for ( ; b != e; ++b )
+						{
+							unsigned int end = hashFunc( b -> first ) % table_size;
+							auto owner = static_cast< unsigned long int >( end ) * threads_ / table_size;
+							parts[t][owner].emplace_back( end, b );
+						}
+					}, slice_begin, slice_end );
+					slice_begin = slice_end;
+				}
+				for ( auto & w : workers ) w.join();
+				workers.clear();
+
+				// Phase 2: each thread inserts in its own range of buckets. Slices are visited in
+				// input order, so a repeated key keeps the data of its last occurrence, like insert().
+				for ( auto t(0u); t != threads_; ++t )
+				{
+					workers.emplace_back( [this, &parts, &inserted, threads_, t]()
+					{
+						KeyEqual equalFunc;
+						unsigned long int count = 0;
+						for ( auto s(0u); s != threads_; ++s )
+						{
+							for ( auto & p : parts[s][t] )
+							{
+								auto & list = m_data_table[p.first];
+								auto i = list.begin();
+								for ( ; i != list.end(); ++i )
+									if ( equalFunc( i -> m_key, p.second -> first ) ) break;
+								if ( i != list.end() ) i -> m_data = p.second -> second;
+								else
+								{
+									list.emplace_front( p.second -> first, p.second -> second );
+									count++;
+								}
+							}
+						}
+						inserted[t] = count;
+					} );
+				}
+				for ( auto & w : workers ) w.join();
+
+				unsigned long int total = 0;
+				for ( auto c : inserted ) total += c;
+				m_count += total;
+				return total;
+			}
+
+			/**
+			 * @brief      Adds delta_ to the data stored under k_, creating the
+			 *             entry with delta_ as its initial value if the key is
+			 *             not on the table yet. The key is hashed only once and
+			 *             its list is walked a single time, so this is the
+			 *             cheap way to use the table as a counter.
+			 *
+			 * @param[in]  k_      The key of the element.
+			 * @param[in]  delta_  Amount to be added. Provided none, default
+			 *                     value is 1.
+			 *
+			 * @return     True if a new entry was created. False if an
+			 *             existing entry was updated.
+			 */
+			bool increment ( const KeyType & k_, const DataType & delta_ = DataType(1) )
+			{
+				// Checks if the load factor is equal to 1.0. If it is, calls for rehash.
+				if ( m_count == m_size ) rehash();
+				KeyHash hashFunc;   // Instantiate the "functor" for primary hash.
+				KeyEqual equalFunc; // Instantiate the "functor" for the equal to test.
+				auto end( hashFunc( k_ ) % m_size );
+				for(auto i = m_data_table[end].begin(); i != m_data_table[end].end(); ++i)
+				{
+					if( equalFunc( i -> m_key, k_ ) )
+					{
+						i -> m_data += delta_;
+						return false;
+					}
+				}
+				// Key not found: the delta is the initial value.
+				m_data_table[end].emplace_front( k_, delta_ );
+				m_count++;
+				return true;
+			}
+
 			/**
 			 * @brief      Removes an element of the table with the same key
 			 *             provided by client.
@@ -250,12 +353,15 @@ namespace ac
 			 *             store them on n_table. After this, all the previous
 			 *             stored elements of m_data_table will be deleted and
 			 *             its new value will be a reference to n_table.
+			 *
+			 * @param[in]  min_size_  Minimum size of the new table. Provided
+			 *                        none, the table only doubles.
 			 */
-			void rehash( void ) //!< Change Hash table size if load factor λ > 1.0
+			void rehash( unsigned int min_size_ = 0 ) //!< Change Hash table size if load factor λ > 1.0
 			{
 				KeyHash hashFunc; // Instantiate the "functor" for primary hash.
-				// New size is the next prime closest to the double previous size.
-				auto n_size = find_Next_Prime(m_size * 2);
+				// New size is the next prime closest to the double previous size (or to the minimum asked).
+				auto n_size = find_Next_Prime( std::max( m_size * 2, min_size_ ) );
 				auto n_table = new std::forward_list<Entry> [n_size];
 				for(auto i(0); i != m_size; ++i)
 				{
@@ -263,12 +369,10 @@ namespace ac
 					{
 						// Calculating new hash for the bigger table.
 						auto n_end ( hashFunc( j -> m_key ) % n_size );
-						n_table[n_end].push_front(*j);
+						n_table[n_end].push_front( std::move(*j) );
 					}
 				}
 
-				return;
-
 				// Deleting reference for the old table and updating it for the new.
 				delete [] m_data_table;
 				m_data_table = n_table;
@@ -0,0 +1,46 @@
+/**
+ * @file    prime.h
+ * @brief   Prime numbers used as sizes for the hash tables.
+ */
+
+#ifndef _PRIME_H_
+#define _PRIME_H_
+
+#include <cmath> // std::sqrt
+
+namespace ac
+{
+	/**
+	 * @brief      Helper function to check if a size is prime or not.
+	 *
+	 * @param[in]  size  Size to be checked.
+	 *
+	 * @return     True if size is prime. False, otherwise.
+	 */
+	inline bool check_Prime ( unsigned int size )
+	{
+		unsigned int i;
+		if(size == 0 || size == 1) return false;
+		for(i = 2; i <= std::sqrt(size); ++i)
+		{
+			if ( size%i == 0 ) return false;
+		}
+		return true;
+	}
+
+	/**
+	 * @brief      Helper function to find the next prime number of a given
+	 *             size.
+	 *
+	 * @param[in]  size  Initial number to find next prime.
+	 *
+	 * @return     The closest prime number of the given size.
+	 */
+	inline unsigned int find_Next_Prime( unsigned int size )
+	{
+		while( not check_Prime(size) ) size++;
+		return size;
+	}
+}
+
+#endif
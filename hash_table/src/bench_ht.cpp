@@ -0,0 +1,74 @@
+/**
+ * @file    bench_ht.cpp
+ * @brief   Timing sequential insert() against bulk_build() of ac::HashTbl.
+ */
+
+#include <iostream>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <utility>
+#include <cstdlib>
+
+#include "hashtbl.h"
+
+using namespace ac;
+
+/**
+ * @brief      Runs a function a few times and returns its average running time.
+ *
+ * @param[in]  runs  How many times the function is run.
+ * @param[in]  f     Function to be timed.
+ *
+ * @tparam     Func  Callable with no arguments.
+ *
+ * @return     Average running time, in milliseconds.
+ */
+template< typename Func >
+double average_time( int runs, Func f )
+{
+    double time_average = 0.0;
+    for( int k = 1; k <= runs; ++k )
+    {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        auto end = std::chrono::steady_clock::now();
+        time_average += ( std::chrono::duration< double, std::milli >( end - start ).count() - time_average ) / k;
+    }
+    return time_average;
+}
+
+int main( int argc, char const **argv )
+{
+    // Input size and number of runs may be given by the command line.
+    unsigned long n = argc > 1 ? std::strtoul( argv[1], nullptr, 10 ) : 5000000;
+    int runs = argc > 2 ? std::atoi( argv[2] ) : 3;
+
+    std::mt19937 g( 42 );
+    std::uniform_int_distribution< long > dist( 0, 4 * static_cast< long >( n ) );
+    std::vector< std::pair< long, long > > input;
+    input.reserve( n );
+    for( unsigned long i = 0; i < n; ++i )
+        input.push_back( std::make_pair( dist( g ), static_cast< long >( i ) ) );
+
+    std::cout << "Method, Threads, Input Size, Average Time (ms)" << std::endl;
+
+    auto t = average_time( runs, [&input]()
+    {
+        HashTbl< long, long > tbl;
+        for( auto & p : input ) tbl.insert( p.first, p.second );
+    } );
+    std::cout << "insert, 1, " << n << ", " << t << std::endl;
+
+    for( auto threads : { 1u, 4u, 16u, 64u } )
+    {
+        t = average_time( runs, [&input, threads]()
+        {
+            HashTbl< long, long > tbl;
+            tbl.bulk_build( input.begin(), input.end(), threads );
+        } );
+        std::cout << "bulk_build, " << threads << ", " << n << ", " << t << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -8,8 +8,11 @@
 #include <functional>
 #include <tuple>
 #include <cassert>
+#include <vector>
+#include <utility>
 
 #include "hashtbl.h"
+#include "hashmultitbl.h"
 
 using namespace ac;
 
@@ -223,5 +226,109 @@ int main()
         }
     }
 
+    {
+        // Testando increment (modo contador).
+        HashTbl< int, int > frequencia( 4 );
+        int valores[] = { 3, 7, 3, 3, 11, 7, 42, 3 };
+        for( auto & v : valores )
+            frequencia.increment( v );
+
+        int n;
+        assert( frequencia.count() == 4 );
+        assert( frequencia.retrieve( 3, n ) and n == 4 );
+        assert( frequencia.retrieve( 7, n ) and n == 2 );
+        assert( frequencia.retrieve( 42, n ) and n == 1 );
+
+        // Delta arbitrario, inclusive negativo.
+        assert( frequencia.increment( 3, -4 ) == false );
+        assert( frequencia.retrieve( 3, n ) and n == 0 );
+        assert( frequencia.increment( 100, 5 ) == true );
+        assert( frequencia.retrieve( 100, n ) and n == 5 );
+
+        // Forca varios rehash.
+        for( auto i(0); i < 1000; ++i )
+            frequencia.increment( i % 250 );
+        assert( frequencia.retrieve( 249, n ) and n == 4 );
+        assert( frequencia.retrieve( 100, n ) and n == 9 );
+    }
+
+    {
+        // Testando HashMultiTbl: todas as contas de uma agencia.
+        HashMultiTbl< int, Account > agencias( 4 );
+        for( auto & e : myAccounts )
+            agencias.insert( e.mBranchCode, e );
+
+        assert( agencias.count() == 8 );
+        assert( agencias.key_count() == 7 );
+        assert( agencias.count( 1668 ) == 2 );
+        assert( agencias.count( 9999 ) == 0 );
+
+        // Os valores de uma chave sao contiguos e mantem a ordem de insercao.
+        auto range = agencias.equal_range( 1668 );
+        assert( range.second - range.first == 2 );
+        assert( *range.first == myAccounts[0] );
+        assert( *(range.first + 1) == myAccounts[1] );
+
+        range = agencias.equal_range( 9999 );
+        assert( range.first == range.second );
+
+        assert( agencias.remove( 1668 ) );
+        assert( agencias.remove( 1668 ) == false );
+        assert( agencias.count() == 6 );
+        assert( agencias.key_count() == 6 );
+
+        agencias.clear();
+        assert( agencias.empty() );
+    }
+
+    {
+        // Testando HashMultiTbl::increment: soma ao ultimo valor da chave.
+        HashMultiTbl< int, int > contadores;
+        assert( contadores.increment( 7 ) == true );
+        assert( contadores.increment( 7, 2 ) == false );
+        contadores.insert( 7, 10 );
+        assert( contadores.increment( 7, 5 ) == false );
+
+        auto range = contadores.equal_range( 7 );
+        assert( range.second - range.first == 2 );
+        assert( range.first[0] == 3 and range.first[1] == 15 );
+        assert( contadores.count() == 2 and contadores.key_count() == 1 );
+
+        // Forca varios rehash.
+        for( auto i(0); i < 1000; ++i )
+            contadores.increment( i % 250 );
+        assert( contadores.count( 249 ) == 1 );
+        assert( contadores.equal_range( 249 ).first[0] == 4 );
+        assert( contadores.key_count() == 250 );
+    }
+
+    {
+        // Testando bulk_build.
+        std::vector< std::pair< int, int > > lote;
+        for( auto i(0); i < 20000; ++i )
+            lote.push_back( std::make_pair( ( i * 7919 ) % 15000, i ) ); // Chaves repetidas.
+
+        HashTbl< int, int > sequencial;
+        for( auto & p : lote )
+            sequencial.insert( p.first, p.second );
+
+        for( auto threads : { 1u, 3u, 8u } )
+        {
+            HashTbl< int, int > paralelo;
+            paralelo.insert( -1, -1 ); // Conteudo anterior deve ser mantido.
+            assert( paralelo.bulk_build( lote.begin(), lote.end(), threads ) == 15000 );
+            assert( paralelo.count() == sequencial.count() + 1 );
+
+            int a, b;
+            assert( paralelo.retrieve( -1, a ) and a == -1 );
+            for( auto i(0); i < 15000; ++i )
+            {
+                assert( sequencial.retrieve( i, a ) );
+                assert( paralelo.retrieve( i, b ) );
+                assert( a == b ); // A ultima ocorrencia vence, como no insert.
+            }
+        }
+    }
+
     return EXIT_SUCCESS;
 }
\ No newline at end of file
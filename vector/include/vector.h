@@ -11,10 +11,16 @@
 
 #include <iostream>
 #include <cassert>
+#include <cstddef>    // std::ptrdiff_t
 #include <iterator>
-#include <cstdlib>
+#include <cstdlib>    // std::malloc, std::realloc, std::free
+#include <cstring>    // std::memcpy, std::memmove
 #include <algorithm>
 #include <initializer_list>
+#include <new>        // placement new
+#include <stdexcept>  // std::out_of_range
+#include <type_traits> // std::is_trivially_copyable, std::is_integral, std::aligned_storage
+#include <utility>    // std::move, std::move_if_noexcept, std::swap
 
 class MyIterator;
 class vector;
@@ -27,7 +33,14 @@ namespace sc
 		private:
 			T *current;
 
+			template <typename U> friend class MyIterator;
+
 		public:
+			using iterator_category = std::random_access_iterator_tag;
+			using value_type = typename std::remove_const<T>::type;
+			using difference_type = std::ptrdiff_t;
+			using pointer = T *;
+			using reference = T &;
 
 			/**
 			 * @brief      Default constructor for MyIterator. Initializes
@@ -38,21 +51,55 @@ namespace sc
 			 */
 			MyIterator(T * ptr_ = nullptr)
 				: current(ptr_)
-				{/* empty */}	
+				{/* empty */}
+
+			/**
+			 * @brief      Converting constructor, from an iterator to a
+			 *             const_iterator.
+			 *
+			 * @param[in]  other  The iterator to be converted.
+			 */
+			template <typename U, typename = typename std::enable_if< std::is_convertible<U *, T *>::value >::type>
+			MyIterator(const MyIterator<U> & other)
+				: current(other.current)
+				{/* empty */}
 
 			/**
 			 * @brief      Dereferencing operator.
 			 *
 			 * @return     Content of attribute current.
 			 */
-			const T & operator*() const
+			T & operator*() const
 			{
 				assert(current 	!= nullptr);
 				return *current;
 			}
 
 			/**
-			 * @brief      Pre-increment operator.  
+			 * @brief      Member access operator.
+			 *
+			 * @return     Attribute current.
+			 */
+			T * operator->() const
+			{
+				assert(current != nullptr);
+				return current;
+			}
+
+			/**
+			 * @brief      Subscript operator.
+			 *
+			 * @param[in]  n     Distance from this iterator.
+			 *
+			 * @return     Content n positions after current.
+			 */
+			T & operator[](difference_type n) const
+			{
+				return current[n];
+			}
+
+			/**
+			 * @brief      Pre-increment operator.
 			 */
 			MyIterator & operator++()
 			{
@@ -90,36 +137,156 @@ namespace sc
 			}
 
 			/**
-			 * @brief      Equality operator. Checks if the data stored on this
-			 *             instance of MyIterator is equal to another
-			 *             MyIterator.
-			 *
-			 * @param[in]  rhs   Another instance to be checked.
-			 *
-			 * @return     True if they are equals. False otherwise.
+			 * @brief      Compound assignment operators. Move the iterator n
+			 *             positions forward or backward.
 			 */
-			bool operator==(const MyIterator & rhs) const
+			MyIterator & operator+=(difference_type n)
 			{
-				return current == rhs.current;
+				current += n;
+				return *this;
+			}
+
+			MyIterator & operator-=(difference_type n)
+			{
+				current -= n;
+				return *this;
 			}
 
 			/**
-			 * @brief      Non-equality operator. Checks if the data stored on
-			 *             this instance of MyIterator is different to another
-			 *             MyIterator.
-			 *
-			 * @param[in]  rhs   Another instance to be checked.
-			 *
-			 * @return     True if they are different. False otherwise.
+			 * @brief      Arithmetic operators. An iterator n positions after
+			 *             or before this one.
 			 */
-			bool operator!=(const MyIterator & rhs) const
+			MyIterator operator+(difference_type n) const
+			{
+				return MyIterator(current + n);
+			}
+
+			friend MyIterator operator+(difference_type n, const MyIterator & it)
+			{
+				return MyIterator(it.current + n);
+			}
+
+			MyIterator operator-(difference_type n) const
 			{
-				return current != rhs.current;
+				return MyIterator(current - n);
 			}
+
+			// Comparison and difference, between iterators and const_iterators alike
+			template <typename A, typename B> friend bool operator==(const MyIterator<A> &, const MyIterator<B> &);
+			template <typename A, typename B> friend bool operator!=(const MyIterator<A> &, const MyIterator<B> &);
+			template <typename A, typename B> friend bool operator<(const MyIterator<A> &, const MyIterator<B> &);
+			template <typename A, typename B> friend bool operator>(const MyIterator<A> &, const MyIterator<B> &);
+			template <typename A, typename B> friend bool operator<=(const MyIterator<A> &, const MyIterator<B> &);
+			template <typename A, typename B> friend bool operator>=(const MyIterator<A> &, const MyIterator<B> &);
+			template <typename A, typename B> friend std::ptrdiff_t operator-(const MyIterator<A> &, const MyIterator<B> &);
+	};
+
+	/**
+	 * @brief      Difference operator. Either side may be an iterator or a
+	 *             const_iterator.
+	 *
+	 * @param[in]  lhs   An iterator.
+	 * @param[in]  rhs   An iterator of the same vector.
+	 *
+	 * @return     How many positions rhs is before lhs.
+	 */
+	template <typename A, typename B>
+	std::ptrdiff_t operator-(const MyIterator<A> & lhs, const MyIterator<B> & rhs)
+	{
+		return lhs.current - rhs.current;
+	}
+
+	/**
+	 * @brief      Equality operator. Checks if two iterators, each one an
+	 *             iterator or a const_iterator, point to the same element.
+	 *
+	 * @param[in]  lhs   An iterator.
+	 * @param[in]  rhs   Another iterator to be checked.
+	 *
+	 * @return     True if they are equals. False otherwise.
+	 */
+	template <typename A, typename B>
+	bool operator==(const MyIterator<A> & lhs, const MyIterator<B> & rhs)
+	{
+		return lhs.current == rhs.current;
+	}
+
+	/**
+	 * @brief      Non-equality operator. Checks if two iterators, each one
+	 *             an iterator or a const_iterator, point to different
+	 *             elements.
+	 *
+	 * @param[in]  lhs   An iterator.
+	 * @param[in]  rhs   Another iterator to be checked.
+	 *
+	 * @return     True if they are different. False otherwise.
+	 */
+	template <typename A, typename B>
+	bool operator!=(const MyIterator<A> & lhs, const MyIterator<B> & rhs)
+	{
+		return lhs.current != rhs.current;
+	}
+
+	/**
+	 * @brief      Ordering operators. An iterator is less than another of
+	 *             the same vector if it comes before it.
+	 */
+	template <typename A, typename B>
+	bool operator<(const MyIterator<A> & lhs, const MyIterator<B> & rhs)
+	{
+		return lhs.current < rhs.current;
+	}
+
+	template <typename A, typename B>
+	bool operator>(const MyIterator<A> & lhs, const MyIterator<B> & rhs)
+	{
+		return lhs.current > rhs.current;
+	}
+
+	template <typename A, typename B>
+	bool operator<=(const MyIterator<A> & lhs, const MyIterator<B> & rhs)
+	{
+		return lhs.current <= rhs.current;
+	}
+
+	template <typename A, typename B>
+	bool operator>=(const MyIterator<A> & lhs, const MyIterator<B> & rhs)
+	{
+		return lhs.current >= rhs.current;
+	}
+
+	/**
+	 * @brief      Memory inside the vector for its first N elements, where
+	 *             they are kept until they do not fit. Takes no space when N
+	 *             is 0.
+	 */
+	template <typename T, std::size_t N>
+	class InlineBuffer
+	{
+		protected:
+			T * _inline( void ) { return reinterpret_cast< T * >( m_buffer ); }
+
+		private:
+			typename std::aligned_storage< sizeof(T), alignof(T) >::type m_buffer[N];
 	};
-	
+
 	template <typename T>
-	class vector{
+	class InlineBuffer<T, 0>
+	{
+		protected:
+			T * _inline( void ) { return nullptr; }
+	};
+
+	/**
+	 * @brief      Sequential container. With N greater than 0 (see
+	 *             small_vector) up to N elements are stored inside the
+	 *             vector itself, and memory is only allocated for more.
+	 *
+	 * @tparam     T     Type of the elements.
+	 * @tparam     N     How many elements fit inside the vector.
+	 */
+	template <typename T, std::size_t N = 0>
+	class vector : private InlineBuffer<T, N> {
 
 		public:
 			using size_type = size_t;
@@ -134,25 +301,304 @@ namespace sc
 		private:
 			size_type m_end;
 			size_type m_capacity;
-			T * m_storage;
+			T * m_storage; // Raw memory: only [0, m_end) holds constructed elements
+
+			// Elements that can be moved with memcpy()/memmove(), and their memory
+			// grown with realloc(), which can remap large blocks instead of copying.
+			using Trivial = std::integral_constant< bool, std::is_trivially_copyable< T >::value >;
+
+			/**
+			 * @brief      Allocates raw memory for n elements, without
+			 *             constructing any of them. Trivial elements get
+			 *             memory from malloc(), so that it can be realloc()ed.
+			 */
+			static T * _allocate( size_type n )
+			{
+				if( n == 0 ) return nullptr;
+				if( not Trivial::value ) return static_cast< T * >( ::operator new( n * sizeof(T) ) );
+				if( void * p = std::malloc( n * sizeof(T) ) ) return static_cast< T * >( p );
+				throw std::bad_alloc();
+			}
+
+			/**
+			 * @brief      Frees memory from _allocate(). The inline buffer is
+			 *             left alone.
+			 */
+			void _deallocate( T * p )
+			{
+				if( p == this->_inline() ) return;
+				if( Trivial::value ) std::free( p );
+				else ::operator delete( p );
+			}
+
+			/**
+			 * @brief      Destroys the elements in [first, last), leaving the
+			 *             memory raw.
+			 */
+			static void _destroy( T * first, T * last )
+			{
+				for( ; first != last; ++first )
+					first->~T();
+			}
+
+			/**
+			 * @brief      Constructs copies of the elements in [first, last)
+			 *             in the raw memory at dst. If a copy throws, the
+			 *             ones already made are destroyed.
+			 */
+			template< typename InputItr >
+			static void _construct( InputItr first, InputItr last, T * dst )
+			{
+				T * cur = dst;
+				try
+				{
+					for( ; first != last; ++first, ++cur )
+						::new (cur) T( *first );
+				}
+				catch( ... )
+				{
+					_destroy( dst, cur );
+					throw;
+				}
+			}
+
+			/**
+			 * @brief      Constructs n elements in the raw memory at dst
+			 *             from the ones at src, then destroys those. Moves
+			 *             them when T's move constructor does not throw and
+			 *             copies them otherwise, so if a copy throws, the
+			 *             elements at src are left untouched.
+			 */
+			static void _relocate( T * src, size_type n, T * dst )
+			{
+				size_type i = 0;
+				try
+				{
+					for( ; i != n; ++i )
+						::new (dst + i) T( std::move_if_noexcept( src[i] ) );
+				}
+				catch( ... )
+				{
+					_destroy( dst, dst + i );
+					throw;
+				}
+				_destroy( src, src + n );
+			}
+
+			/**
+			 * @brief      Moves the elements to a new space of memory with
+			 *             room for new_capacity elements.
+			 */
+			void _reallocate( size_type new_capacity )
+			{
+				_reallocate( new_capacity, Trivial() );
+			}
+
+			void _reallocate( size_type new_capacity, std::false_type )
+			{
+				T * temp;
+				if( N > 0 and new_capacity <= N )
+				{
+					// Back to the inline buffer, if not there yet
+					if( m_storage == this->_inline() ) return;
+					temp = this->_inline();
+					new_capacity = N;
+				}
+				else
+					temp = _allocate( new_capacity );
+				try { _relocate( m_storage, m_end, temp ); }
+				catch( ... ) { _deallocate( temp ); throw; }
+				_deallocate( m_storage );
+				m_storage = temp;
+				m_capacity = new_capacity;
+			}
+
+			void _reallocate( size_type new_capacity, std::true_type )
+			{
+				if( N > 0 and new_capacity <= N )
+				{
+					if( m_storage == this->_inline() ) return;
+					std::memcpy( static_cast< void * >( this->_inline() ), m_storage, m_end * sizeof(T) );
+					std::free( m_storage );
+					m_storage = this->_inline();
+					new_capacity = N;
+				}
+				else if( new_capacity == 0 )
+				{
+					std::free( m_storage );
+					m_storage = nullptr;
+				}
+				else if( N > 0 and m_storage == this->_inline() )
+				{
+					// The inline buffer cannot be realloc()ed
+					T * temp = _allocate( new_capacity );
+					std::memcpy( static_cast< void * >( temp ), m_storage, m_end * sizeof(T) );
+					m_storage = temp;
+				}
+				else
+				{
+					void * p = std::realloc( m_storage, new_capacity * sizeof(T) );
+					if( p == nullptr ) throw std::bad_alloc();
+					m_storage = static_cast< T * >( p );
+				}
+				m_capacity = new_capacity;
+			}
+
+			/**
+			 * @brief      Makes room for n more elements, doubling the
+			 *             capacity as many times as needed.
+			 */
+			void _grow( size_type n = 1 )
+			{
+				if( m_end + n <= m_capacity ) return;
+				auto new_capacity = m_capacity == 0 ? size_type(DEFAULT_SIZE) : m_capacity;
+				while( new_capacity < m_end + n ) new_capacity *= 2;
+				_reallocate( new_capacity );
+			}
+
+			/**
+			 * @brief      Moves the elements in [pos, m_end) count positions
+			 *             to the right, leaving [pos, pos + count) raw. There
+			 *             must be room for count more elements.
+			 */
+			void _open_gap( size_type pos, size_type count )
+			{
+				if( count == 0 ) return;
+				if( Trivial::value )
+				{
+					std::memmove( static_cast< void * >( m_storage + pos + count ), m_storage + pos, ( m_end - pos ) * sizeof(T) );
+					return;
+				}
+				for( auto i(m_end); i != pos; --i )
+				{
+					::new (m_storage + i - 1 + count) T( std::move( m_storage[i - 1] ) );
+					m_storage[i - 1].~T();
+				}
+			}
+
+			/**
+			 * @brief      Destroys the elements in [pos, pos + count) and
+			 *             moves the ones after them count positions to the
+			 *             left.
+			 */
+			void _close_gap( size_type pos, size_type count )
+			{
+				if( count == 0 ) return;
+				_destroy( m_storage + pos, m_storage + pos + count );
+				if( Trivial::value )
+				{
+					std::memmove( static_cast< void * >( m_storage + pos ), m_storage + pos + count, ( m_end - pos - count ) * sizeof(T) );
+					m_end -= count;
+					return;
+				}
+				for( auto i(pos + count); i != m_end; ++i )
+				{
+					::new (m_storage + i - count) T( std::move( m_storage[i] ) );
+					m_storage[i].~T();
+				}
+				m_end -= count;
+			}
+
+			/**
+			 * @brief      Destroys the elements of this vector and takes the
+			 *             ones of other, which is left empty. Memory from the
+			 *             heap changes hands; elements in an inline buffer
+			 *             are moved one by one.
+			 */
+			void _take( vector & other )
+			{
+				_destroy( m_storage, m_storage + m_end );
+				m_end = 0;
+				if( N > 0 and other.m_storage == other._inline() )
+				{
+					// At most N elements, and this vector has room for N
+					_relocate( other.m_storage, other.m_end, m_storage );
+					m_end = other.m_end;
+					other.m_end = 0;
+					return;
+				}
+				_deallocate( m_storage );
+				m_end = other.m_end;
+				m_capacity = other.m_capacity;
+				m_storage = other.m_storage;
+				other.m_end = 0;
+				other.m_capacity = N;
+				other.m_storage = other._inline();
+			}
+
+			/**
+			 * @brief      Exchanges the contents of two vectors.
+			 */
+			void _swap( vector & other )
+			{
+				if( N == 0 or ( m_storage != this->_inline() and other.m_storage != other._inline() ) )
+				{
+					std::swap( m_end, other.m_end );
+					std::swap( m_capacity, other.m_capacity );
+					std::swap( m_storage, other.m_storage );
+					return;
+				}
+				vector temp;
+				temp._take( other );
+				other._take( *this );
+				_take( temp );
+			}
+
+			/**
+			 * @brief      Inserts the values first, first + 1, ..., last - 1
+			 *             at pos, when insert() is given two numbers.
+			 */
+			template< typename Integral >
+			iterator _insert_range( size_type pos, Integral first, Integral last, std::true_type )
+			{
+				size_type count = last - first;
+				_grow(count);
+				_open_gap(pos, count);
+				for( size_type i = pos; i != pos + count; ++i, ++first )
+					::new (m_storage + i) T(first);
+				m_end += count;
+				return iterator(m_storage + pos);
+			}
+
+			/**
+			 * @brief      Inserts copies of the elements in [first, last) at
+			 *             pos. They are copied before making room, as the
+			 *             range may be part of this vector.
+			 */
+			template< typename InputItr >
+			iterator _insert_range( size_type pos, InputItr first, InputItr last, std::false_type )
+			{
+				vector temp(first, last);
+				_grow(temp.m_end);
+				_open_gap(pos, temp.m_end);
+				for( size_type i = 0; i != temp.m_end; ++i )
+					::new (m_storage + pos + i) T(std::move(temp.m_storage[i]));
+				m_end += temp.m_end;
+				return iterator(m_storage + pos);
+			}
 
 		public:
 			/// [I] SEPECIAL MEMBERS
-			
+
 			/**
 			 * @brief      Default constructor. Initializes attributes with
 			 *             default values.
 			 */
 			vector()
 				: m_end(0)
-				, m_capacity(DEFAULT_SIZE)
-				, m_storage(new T[m_capacity])
+				, m_capacity(N > 0 ? N : size_type(DEFAULT_SIZE))
+				, m_storage(N > 0 ? this->_inline() : _allocate(m_capacity))
 				{ /* empty */ }
 
 			/**
-			 * @brief      Default destructor. Destroys m_storage.
+			 * @brief      Default destructor. Destroys the elements and frees
+			 *             m_storage.
 			 */
-			~vector() { delete [] m_storage; }
+			~vector()
+			{
+				_destroy( m_storage, m_storage + m_end );
+				_deallocate( m_storage );
+			}
 
 			/**
 			 * @brief      Copy constructor. Creates a vector with same
@@ -162,11 +608,26 @@ namespace sc
 			 */
 			vector(const vector & other)
 				: m_end(other.m_end)
-				, m_capacity(other.m_capacity)
-				, m_storage(new T[m_capacity])
+				, m_capacity(other.m_capacity > N ? other.m_capacity : N)
+				, m_storage(m_capacity > N ? _allocate(m_capacity) : this->_inline())
 			{
-				for(auto i(0u); i != m_end; ++i)
-					m_storage[i] = other.m_storage[i];
+				try { _construct( other.m_storage, other.m_storage + m_end, m_storage ); }
+				catch( ... ) { _deallocate( m_storage ); throw; }
+			}
+
+			/**
+			 * @brief      Move constructor. Takes the elements of the vector
+			 *             given by parameter, which is left empty and with no
+			 *             capacity (or with its inline buffer only).
+			 *
+			 * @param      other  Vector to take the elements from.
+			 */
+			vector(vector && other) noexcept( N == 0 or std::is_nothrow_move_constructible<T>::value )
+				: m_end(0)
+				, m_capacity(N)
+				, m_storage(this->_inline())
+			{
+				_take(other);
 			}
 
 			/**
@@ -177,10 +638,10 @@ namespace sc
 			 */
 			vector(size_type n)
 				: m_end(0)
-				, m_capacity(n)
-				, m_storage (new T[m_capacity])
+				, m_capacity(n > N ? n : N)
+				, m_storage (n > N ? _allocate(m_capacity) : this->_inline())
 				{ /* empty */ }
-			
+
 			/**
 			 * @brief      Constructor with range. Creates a vector with
 			 *             elements in the range given by the client.
@@ -200,15 +661,14 @@ namespace sc
 				{
 					distance++;
 					f++;
-				}	
+				}
 
 				m_end = size_type(distance);
-				m_capacity = size_type(distance);
-				m_storage = new T[m_capacity];
+				m_capacity = m_end > N ? m_end : N;
+				m_storage = m_end > N ? _allocate(m_capacity) : this->_inline();
 
- 				auto it = first;
-				for(auto i(0u); i != distance; ++i, ++it)
-					m_storage[i] = *it;
+				try { _construct( first, last, m_storage ); }
+				catch( ... ) { _deallocate( m_storage ); throw; }
 			}
 
 			/**
@@ -220,16 +680,31 @@ namespace sc
 			 */
 			vector & operator= (const vector &v)
 			{
-				m_end = v.m_end;
-				m_capacity = v.m_capacity;
-				m_storage = new T[m_capacity];
-				for(auto i(0u); i != m_end; ++i)
-					m_storage[i] = v.m_storage[i];
+				if( this != &v )
+				{
+					vector temp(v);
+					_take(temp);
+				}
+				return *this;
+			}
+
+			/**
+			 * @brief      Move assignment operator. Destroys the elements of
+			 *             this vector and takes the ones of the vector given
+			 *             by parameter, which is left empty and with no
+			 *             capacity (or with its inline buffer only).
+			 *
+			 * @param      v     Vector to take the elements from.
+			 */
+			vector & operator= (vector &&v) noexcept( N == 0 or std::is_nothrow_move_constructible<T>::value )
+			{
+				if( this != &v )
+					_take(v);
 				return *this;
 			}
 
 			/// [II] ITERATORS
-	
+
 			/**
 			 * @brief      This function retrieves the reference for the address
 			 *             of the beginning of the vector.
@@ -238,7 +713,7 @@ namespace sc
 			 */
 			iterator begin( void )
 			{
-				return iterator(&m_storage[0]);
+				return iterator(m_storage);
 			}
 
 			/**
@@ -249,7 +724,21 @@ namespace sc
 			 */
 			iterator end( void )
 			{
-				return iterator(&m_storage[m_end]);
+				return iterator(m_storage + m_end);
+			}
+
+			/**
+			 * @brief      Iterators to the beginning and the ending of a
+			 *             constant vector.
+			 */
+			const_iterator begin( void ) const
+			{
+				return const_iterator(m_storage);
+			}
+
+			const_iterator end( void ) const
+			{
+				return const_iterator(m_storage + m_end);
 			}
 
 			/**
@@ -260,7 +749,7 @@ namespace sc
 			 */
 			const_iterator cbegin( void ) const
 			{
-				return const_iterator(&m_storage[0]);
+				return const_iterator(m_storage);
 			}
 
 			/**
@@ -271,11 +760,11 @@ namespace sc
 			 */
 			const_iterator cend( void ) const
 			{
-				return const_iterator(&m_storage[m_end]);
+				return const_iterator(m_storage + m_end);
 			}
 
 			/// [III] CAPACITY
-			
+
 			/**
 			 * @brief      This function retrives the logical size of the
 			 *             vector, i.e. how many elements are stored.
@@ -308,7 +797,7 @@ namespace sc
 				return m_end == 0;
 			}
 
-			/// [IV] MODIFIERS			
+			/// [IV] MODIFIERS
 
 			/**
 			 * @brief      This function deletes all elements stored on vector
@@ -317,10 +806,11 @@ namespace sc
 			 */
 			void clear ( void )
 			{
-				delete [] m_storage;
+				_destroy( m_storage, m_storage + m_end );
+				_deallocate( m_storage );
 				m_end = 0;
-				m_capacity = 0; 
-				m_storage = nullptr;
+				m_capacity = N;
+				m_storage = this->_inline();
 			}
 
 			/**
@@ -334,14 +824,12 @@ namespace sc
 			 */
 			void push_front(const_reference ref)
 			{
-				if( m_end == m_capacity )
-                   reserve(m_capacity * 2);
-
-                for(auto i(m_end+1); i != 0; --i)
-                    m_storage[i] = m_storage[i-1];
-
-                m_end++;
-                m_storage[0] = ref;
+				// ref may be an element of this vector, which is about to move
+				T value(ref);
+				_grow();
+				_open_gap(0, 1);
+				::new (m_storage) T(std::move(value));
+				m_end++;
 			}
 
 			/**
@@ -354,9 +842,34 @@ namespace sc
 			void push_back(const_reference ref)
 			{
 				if( m_end == m_capacity )
-					reserve( 2 * m_capacity );
-	
-				m_storage[m_end++] = ref;
+				{
+					// ref may be an element of this vector, which is about to move
+					T value(ref);
+					_grow();
+					::new (m_storage + m_end) T(std::move(value));
+				}
+				else
+					::new (m_storage + m_end) T(ref);
+				m_end++;
+			}
+
+			/**
+			 * @brief      Pushes a new element at the end of the vector,
+			 *             moving it instead of copying it.
+			 *
+			 * @param[in]  ref   The element to be moved into the vector.
+			 */
+			void push_back(T && ref)
+			{
+				if( m_end == m_capacity )
+				{
+					T value(std::move(ref));
+					_grow();
+					::new (m_storage + m_end) T(std::move(value));
+				}
+				else
+					::new (m_storage + m_end) T(std::move(ref));
+				m_end++;
 			}
 
 			/**
@@ -364,11 +877,10 @@ namespace sc
 			 *             vector.
 			 */
 			void pop_back( void )
-			{			
+			{
 				if( empty() )
 					throw std::out_of_range("Unnable to pop an element of an empty vector. \n");
-				m_storage[--m_end];
-
+				m_storage[--m_end].~T();
 			}
 
 			/**
@@ -377,10 +889,9 @@ namespace sc
 			 */
 			void pop_front( void )
 			{
-				for(auto i(0u); i != m_end; ++i)
-                    m_storage[i] = m_storage[i+1];
-                m_end--;
-
+				if( empty() )
+					throw std::out_of_range("Unnable to pop an element of an empty vector. \n");
+				_close_gap(0, 1);
 			}
 
 			/**
@@ -396,22 +907,17 @@ namespace sc
 			 *
 			 * @return     Iterator to position of the new stored element.
 			 */
-			iterator insert( iterator at, const_reference ref )
-			{				
-				auto it = begin();
-				unsigned int counter = 0;
-				
-				for(counter = 0; it != at; ++it, ++counter);
-				
-				if( m_end == m_capacity )
-					reserve( 2 * m_capacity );
-				
-				for( auto i(m_end+1); i != counter; --i )
-					m_storage[i] = m_storage[i-1];
+			iterator insert( const_iterator at, const_reference ref )
+			{
+				size_type counter = at - cbegin();
+
+				T value(ref);
+				_grow();
+				_open_gap(counter, 1);
 
-				m_storage[counter] = ref;
+				::new (m_storage + counter) T(std::move(value));
 				m_end++;
-				return it;
+				return iterator(m_storage + counter);
 			}
 
 			/**
@@ -428,105 +934,62 @@ namespace sc
 			 * @param[in]  _last     Where the range ends.
 			 *
 			 * @tparam     InputItr  Iterator with reference to begin and end of
-			 *                       the range.
+			 *                       the range. Given two numbers instead, the
+			 *                       values _first, _first + 1, ..., _last - 1
+			 *                       are inserted.
 			 *
 			 * @return     Iterator to position of the new stored range.
 			 */
 			template<typename InputItr>
-			iterator insert(iterator at, InputItr _first, InputItr _last)
-			{				
-				auto total_distance = _last - _first;
-				auto first = _first;
-				auto _begin = begin();
-				unsigned int start = 0;
-
-				for(; _begin != at; ++_begin, ++start);
-
-				while(m_end + total_distance > m_capacity)
-					reserve(2*m_capacity);
-
-				for(auto i(m_end + total_distance); i != start; --i)
-					m_storage[i] = m_storage[i - total_distance]; 
-			
-				for(auto i(start); i != start+total_distance; ++i)
-				{
-					m_storage[i] = first;
-					first++;
-				}
-				m_end += total_distance;
-
-				return _begin;
+			iterator insert(const_iterator at, InputItr _first, InputItr _last)
+			{
+				return _insert_range(at - cbegin(), _first, _last, std::is_integral<InputItr>());
 			}
 
 			/**
 			 * @brief      This function inserts list of elements on the vector
 			 *             at a position given by the client. Checks if the
 			 *             vector can store the list and makes the required
-			 *             adjustments (if needed) on the capacity. After this,
-			 *             moves all elements for the right (to open space for
-			 *             the list) and stores the list.
+			 *             adjustments (if needed) on the capacity. The list is
+			 *             copied first, so a throwing copy leaves the vector
+			 *             unchanged; then moves all elements for the right (to
+			 *             open space for the list) and stores the copies.
 			 *
 			 * @param[in]  at    Where the list will begin to be stored.
 			 * @param[in]  list  The list of elements to be stored.
 			 *
 			 * @return     Iterator to position of the new stored elements.
 			 */
-			iterator insert(iterator at, std::initializer_list<value_type> list)
-			{				
-				auto total_distance = list.size();
-				auto _begin = begin();
-				unsigned int start = 0;
-
-				for(; _begin != at; ++_begin, ++start);
-
-				while(m_end + total_distance > m_capacity)
-					reserve( 2 * m_capacity );
-				
-				for(auto i(m_end + total_distance); i != start; --i)
-					m_storage[i] = m_storage[i - total_distance]; 
-				
-				for(auto &ref: list)
-					m_storage[start++] = ref;
-				
-				m_end += total_distance;
-
-				return _begin;
+			iterator insert(const_iterator at, std::initializer_list<value_type> list)
+			{
+				return _insert_range(at - cbegin(), list.begin(), list.end(), std::false_type());
 			}
 
 			/**
 			 * @brief      Creates a new space of memory with the size of
-			 *             new_size, makes the copy of all elements stored on
-			 *             the previous address and deletes its reference.
+			 *             new_size, moves all elements stored on the previous
+			 *             address (copies them, if their move constructor may
+			 *             throw) and frees it.
 			 *
 			 * @param[in]  new_size  The new memory size.
 			 */
 			void reserve(size_type new_size)
 			{
-				
 				if(new_size <= m_capacity) return;
-				T * temp = new T[new_size];  
-				for(auto i(0u); i < m_capacity; ++i)
-					temp[i] = m_storage[i];
-				delete [] m_storage;
-				m_storage = temp;
-				m_capacity = new_size;
+				_reallocate(new_size);
 			}
 
 			/**
 			 * @brief      When called, this function will create another space
 			 *             of memory where its size is exactly the number of
 			 *             elements that are actualy stored on the vector. It
-			 *             will make a copy of all elements of the old space and
-			 *             delete its reference.
+			 *             will move all elements of the old space there and
+			 *             free it.
 			 */
 			void shrink_to_fit( void )
 			{
-				T * temp = new T[m_end];  
-				for(auto i(0); i < m_end; ++i)
-					temp[i] = m_storage[i];
-				delete [] m_storage;
-				m_storage = temp;
-				m_capacity = m_end;
+				if(m_end == m_capacity) return;
+				_reallocate(m_end);
 			}
 
 			/**
@@ -548,7 +1011,8 @@ namespace sc
 			/**
 			 * @brief      This function will replace all previous stored
 			 *             elements of the vector for the list provided by the
-			 *             client.
+			 *             client, repeating the list if it is shorter than the
+			 *             vector.
 			 *
 			 * @param[in]  list  The list holding the values to be assigned.
 			 */
@@ -556,18 +1020,10 @@ namespace sc
 			{
 				if( empty() )
 					throw std::out_of_range("Unable to assign values to an empty vector. \n");
-								
-				size_type i = 0;
-				auto cont(0u);
-				
-				while(cont < m_end)
-				{
-					for(auto &ref: list)
-					{
-						m_storage[i++] = ref;
-						cont++;
-					}
-				}
+				if( list.size() == 0 ) return;
+
+				for(size_type i = 0; i != m_end; ++i)
+					m_storage[i] = list.begin()[i % list.size()];
 			}
 
 			/**
@@ -582,24 +1038,8 @@ namespace sc
 			template<typename InputItr>
 			void assign(InputItr first, InputItr last)
 			{
-				int distance(0);
-				auto f = first;
-
-				while( f != last )
-				{
-					distance++;
-					f++;
-				}
-
-				T * temp = new T[distance];
-				delete [] m_storage;
-				m_end = size_type(distance);
-				m_capacity = size_type(distance);
-				m_storage = temp;
-
- 				auto it = first;
-				for(auto i(0u); i != distance; ++i, ++it)
-					m_storage[i] = *it;
+				vector temp(first, last);
+				_take(temp);
 			}
 
 			/**
@@ -610,24 +1050,14 @@ namespace sc
 			 * @param[in]  _first  Where the interval begins.
 			 * @param[in]  _last   Where the interval ends.
 			 *
-			 * @return     Iterator pointing to the position where the last
-			 *             element was erased.
+			 * @return     Iterator pointing to the element that followed the
+			 *             erased ones.
 			 */
-			iterator erase( iterator _first, iterator _last )
+			iterator erase( const_iterator _first, const_iterator _last )
 			{
-				auto x = _first;
-				auto y = begin();
-				unsigned int start = 0;
-				int counter = 0;
-
-				while(x++ != _last)	counter++;
-				while(y != _first) start++;
-
-				for(auto i(start); i != m_end - counter; ++i)
-					m_storage[i] = m_storage[ i + counter ];
-
-				m_end -= counter;
-				return x;
+				size_type start = _first - cbegin();
+				_close_gap(start, _last - _first);
+				return iterator(m_storage + start);
 			}
 
 			/**
@@ -643,18 +1073,11 @@ namespace sc
 			 * @return     Iterator pointing to the position where the element
 			 *             was deleted.
 			 */
-			iterator erase(iterator it)
+			iterator erase(const_iterator it)
 			{
-				auto _begin = begin();
-				int counter = 0;
-
-				for(; it != _begin; ++_begin, ++counter);
-
-				for(auto i(counter); i != m_end - 1; ++i)
-					m_storage[i] = m_storage[i+1];
-
-				m_end--;
-				return iterator(_begin);
+				size_type counter = it - cbegin();
+				_close_gap(counter, 1);
+				return iterator(m_storage + counter);
 			}
 
 			/// [V] ELEMENT ACCESS
@@ -804,7 +1227,7 @@ namespace sc
 			 * @param      v_    The vector that will have its elements printed.
 			 *
 			 */
-			friend std::ostream & operator<< ( std::ostream & os_, vector<T> & v_ )
+			friend std::ostream & operator<< ( std::ostream & os_, vector & v_ )
 			{
 				if( v_.empty() )
 				{
@@ -819,27 +1242,26 @@ namespace sc
 			
 			/**
 			 * @brief      This function simply swaps all values between two
-			 *             vectors.
+			 *             vectors, either of which may be empty.
 			 *
 			 * @param      first_   The vector that will have its elements
 			 *                      swaped with the second vector.
 			 * @param      second_  The vector that will have its elements
 			 *                      swaped with the first vector.
 			 */
-			friend void swap( vector<T> & first_, vector<T> & second_ )
+			friend void swap( vector & first_, vector & second_ )
 			{
-				if( first_.empty() or second_.empty() )
-				{
-					std::cout << "Unable to make operations with an empty vector." << std::endl;
-					return;
-				}
-
-				vector<T> temp = first_;
-
-				first_ = second_;
-				second_ = temp;
+				first_._swap( second_ );
 			}
-	};	
+	};
+
+	/**
+	 * @brief      A vector that keeps up to N elements inside itself, and
+	 *             only allocates memory when it holds more than that. It has
+	 *             the interface of sc::vector.
+	 */
+	template <typename T, std::size_t N>
+	using small_vector = vector<T, N>;
 }
 
 #endif
\ No newline at end of file
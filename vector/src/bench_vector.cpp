@@ -0,0 +1,275 @@
+/**
+ * @file    bench_vector.cpp
+ * @brief   Counting the allocations, copies and moves made by the vector.
+ */
+
+#include <iostream>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "vector.h"
+
+/// Allocations made through operator new, std::string buffers included.
+static long g_allocations = 0;
+
+/// Keeps the short vectors from being optimized away.
+static volatile int g_sink = 0;
+
+void * operator new( std::size_t size )
+{
+	++g_allocations;
+	if( void * p = std::malloc( size ? size : 1 ) ) return p;
+	throw std::bad_alloc();
+}
+
+void operator delete( void * p ) noexcept { std::free( p ); }
+void operator delete( void * p, std::size_t ) noexcept { std::free( p ); }
+
+/**
+ * @brief      A std::string that counts how many times it is copied and
+ *             moved. The strings used are too long to be stored inline, so
+ *             each copy also allocates.
+ */
+struct Tracked
+{
+	static long copies;
+	static long moves;
+
+	std::string value;
+
+	Tracked( void ) { /* empty */ }
+	Tracked( const std::string & v ) : value(v) { /* empty */ }
+	Tracked( const Tracked & other ) : value(other.value) { ++copies; }
+	Tracked( Tracked && other ) noexcept : value(std::move(other.value)) { ++moves; }
+	Tracked & operator=( const Tracked & other ) { value = other.value; ++copies; return *this; }
+	Tracked & operator=( Tracked && other ) noexcept { value = std::move(other.value); ++moves; return *this; }
+	bool operator!=( const Tracked & other ) const { return value != other.value; }
+};
+
+long Tracked::copies = 0;
+long Tracked::moves = 0;
+
+/**
+ * @brief      Runs a function a few times, each one after an untimed setup,
+ *             and prints its average running time and the allocations,
+ *             copies and moves made by the last run.
+ */
+template< typename Setup, typename Func >
+void report( const std::string & structure, const std::string & scenario, long n, int runs, Setup setup, Func f )
+{
+	double time_average = 0.0;
+	long allocations = 0, copies = 0, moves = 0;
+	for( int k = 1; k <= runs; ++k )
+	{
+		setup();
+		allocations = g_allocations; copies = Tracked::copies; moves = Tracked::moves;
+		auto start = std::chrono::steady_clock::now();
+		f();
+		auto end = std::chrono::steady_clock::now();
+		allocations = g_allocations - allocations; copies = Tracked::copies - copies; moves = Tracked::moves - moves;
+		time_average += ( std::chrono::duration< double, std::milli >( end - start ).count() - time_average ) / k;
+	}
+	std::cout << structure << ", " << scenario << ", " << n << ", " << allocations << ", "
+			  << copies << ", " << moves << ", " << time_average << std::endl;
+}
+
+/**
+ * @brief      Passes a vector by value and returns it.
+ */
+template< typename Vector >
+Vector pass( Vector v )
+{
+	return v;
+}
+
+/**
+ * @brief      The scenarios, for sc::vector and std::vector of Tracked:
+ *             growing from empty by push_back() of copies and of
+ *             temporaries, reserving twice the size of a full vector,
+ *             passing a vector to a function by value and returning it,
+ *             and move assignment.
+ */
+template< typename Vector >
+void bench( const std::string & name, long n, int runs )
+{
+	std::vector< std::string > pool;
+	for( long i = 0; i < n; ++i )
+		pool.push_back( "a string long enough for the heap #" + std::to_string( i ) );
+
+	Vector v, w;
+	auto fill = [&]() { v = Vector(); for( auto & s : pool ) v.push_back( Tracked( s ) ); };
+
+	report( name, "push_back copies", n, runs, [&]() { v = Vector(); }, [&]()
+	{
+		Tracked t( pool[0] );
+		for( long i = 0; i < n; ++i ) v.push_back( t );
+	} );
+	report( name, "push_back temporaries", n, runs, [&]() { v = Vector(); }, [&]()
+	{
+		for( auto & s : pool ) v.push_back( Tracked( s ) );
+	} );
+	report( name, "reserve(2n)", n, runs, [&]() { fill(); v.shrink_to_fit(); }, [&]()
+	{
+		v.reserve( 2 * n );
+	} );
+	report( name, "pass and return by value", n, runs, fill, [&]()
+	{
+		w = pass( std::move( v ) );
+	} );
+	report( name, "move assignment", n, runs, fill, [&]()
+	{
+		w = std::move( v );
+	} );
+}
+
+/**
+ * @brief      An int with a copy constructor of its own, which makes the
+ *             vector move it one element at a time, as any class type.
+ */
+struct Boxed
+{
+	int value;
+
+	Boxed( int v = 0 ) : value(v) { /* empty */ }
+	Boxed( const Boxed & other ) : value(other.value) { /* empty */ }
+	Boxed & operator=( const Boxed & other ) { value = other.value; return *this; }
+};
+
+/**
+ * @brief      Runs a function a few times, each one after an untimed setup,
+ *             and returns its average running time.
+ */
+template< typename Setup, typename Func >
+double average_time( int runs, Setup setup, Func f )
+{
+	double time_average = 0.0;
+	for( int k = 1; k <= runs; ++k )
+	{
+		setup();
+		auto start = std::chrono::steady_clock::now();
+		f();
+		auto end = std::chrono::steady_clock::now();
+		time_average += ( std::chrono::duration< double, std::milli >( end - start ).count() - time_average ) / k;
+	}
+	return time_average;
+}
+
+/**
+ * @brief      Trivially copyable elements: building a vector of n ints by
+ *             push_back() from empty, then 10 push_front() and 10
+ *             pop_front() on it. int takes the memcpy()/realloc() path,
+ *             Boxed the element by element one.
+ */
+template< typename Vector >
+void bench_trivial( const std::string & name, long n, int runs )
+{
+	Vector v;
+	std::cout << name << ", build by push_back, " << n << ", "
+			  << average_time( runs, [&]() { v = Vector(); }, [&]()
+			  {
+				  for( long i = 0; i < n; ++i ) v.push_back( int(i) );
+			  } ) << std::endl;
+	std::cout << name << ", 10 push_front + 10 pop_front, " << n << ", "
+			  << average_time( runs, [](){}, [&]()
+			  {
+				  for( int i = 0; i < 10; ++i ) v.push_front( i );
+				  for( int i = 0; i < 10; ++i ) v.pop_front();
+			  } ) << std::endl;
+}
+
+/**
+ * @brief      Random access: std::sort() of n random ints, and 1000
+ *             insertions and erasures at iterators 10 positions before
+ *             end(), which insert() and erase() now locate in O(1).
+ */
+template< typename Vector >
+void bench_iterator( const std::string & name, long n, int runs )
+{
+	std::mt19937 g( 42 );
+	std::vector< int > values( n );
+	for( auto & x : values ) x = int( g() );
+
+	Vector v;
+	std::cout << name << ", std::sort, " << n << ", "
+			  << average_time( runs, [&]() { v = Vector(); for( auto x : values ) v.push_back( x ); }, [&]()
+			  {
+				  std::sort( v.begin(), v.end() );
+			  } ) << std::endl;
+	std::cout << name << ", 1000 insert + erase near end, " << n << ", "
+			  << average_time( runs, [](){}, [&]()
+			  {
+				  for( int i = 0; i < 1000; ++i ) v.erase( v.insert( v.end() - 10, i ) );
+			  } ) << std::endl;
+}
+
+/**
+ * @brief      Short vectors: creating, filling by push_back() and destroying
+ *             n vectors, each one with a random size from 1 to max_size + 1.
+ *             Boxed is used so that every allocation goes through operator
+ *             new. Prints the allocations made by the last run and the
+ *             average running time.
+ */
+template< typename Vector >
+void bench_short( const std::string & name, long n, int max_size, int runs )
+{
+	std::mt19937 g( 42 );
+	std::vector< int > sizes( n );
+	for( auto & x : sizes ) x = int( g() % ( max_size + 1 ) );
+
+	long allocations = 0;
+	double time = average_time( runs, [&]() { allocations = g_allocations; }, [&]()
+	{
+		for( auto size : sizes )
+		{
+			Vector v;
+			v.push_back( size );
+			for( int i = 0; i < size; ++i ) v.push_back( i );
+			g_sink = g_sink + v[ v.size() / 2 ].value;
+		}
+	} );
+	allocations = g_allocations - allocations;
+	std::cout << name << ", sizes 1 to " << max_size + 1 << ", " << n << ", " << allocations << ", "
+			  << time << std::endl;
+}
+
+int main( int argc, char const **argv )
+{
+	long max_n = argc > 1 ? std::atol( argv[1] ) : 1000000;
+	int runs = argc > 2 ? std::atoi( argv[2] ) : 3;
+	long max_build = argc > 3 ? std::atol( argv[3] ) : 100000000;
+	long max_short = argc > 4 ? std::atol( argv[4] ) : 1000000;
+
+	std::cout << "Structure, Scenario, Input Size, Allocations, Copies, Moves, Average Time (ms)" << std::endl;
+	for( long n = 1000; n <= max_n; n *= 10 )
+	{
+		bench< sc::vector< Tracked > >( "sc::vector", n, runs );
+		bench< std::vector< Tracked > >( "std::vector", n, runs );
+	}
+
+	std::cout << std::endl << "Structure, Scenario, Input Size, Average Time (ms)" << std::endl;
+	for( long n = 1000000; n <= max_build; n *= 10 )
+	{
+		bench_trivial< sc::vector< int > >( "sc::vector<int>", n, runs );
+		bench_trivial< sc::vector< Boxed > >( "sc::vector<Boxed>", n, runs );
+	}
+	for( long n = 1000000; n <= std::min( max_build, 10000000L ); n *= 10 )
+	{
+		bench_iterator< sc::vector< int > >( "sc::vector<int>", n, runs );
+		bench_iterator< std::vector< int > >( "std::vector<int>", n, runs );
+	}
+
+	std::cout << std::endl << "Structure, Scenario, Input Size, Allocations, Average Time (ms)" << std::endl;
+	for( int max_size : { 15, 63 } )
+	{
+		bench_short< sc::vector< Boxed > >( "sc::vector<Boxed>", max_short, max_size, runs );
+		bench_short< sc::small_vector< Boxed, 16 > >( "sc::small_vector<Boxed, 16>", max_short, max_size, runs );
+		bench_short< std::vector< Boxed > >( "std::vector<Boxed>", max_short, max_size, runs );
+	}
+	return EXIT_SUCCESS;
+}
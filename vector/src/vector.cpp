@@ -6,6 +6,10 @@
  * @since   21/10/2017
  */
 
+#include <algorithm>
+#include <iterator>
+#include <string>
+
 #include "vector.h"
 
 int main(){
@@ -215,4 +219,109 @@ int main(){
 		std::cout << ">>> Vector B after swap():" << std::endl;
 		std::cout << b << std::endl;
 	}
+
+	std::cout << std::endl;
+	{
+		std::cout << "Testing - Move Constructor | Move Assignment | Shrink_To_Fit():" << std::endl << std::endl;
+		std::cout << "Pushing back to vector A strings long enough to live on the heap:" << std::endl;
+		sc::vector<std::string> a;
+		for(auto i(0); i < 5; ++i) a.push_back("a rather long string number " + std::to_string(i));
+
+		std::cout << ">>> Vector A: " << std::endl;
+		std::cout << a << std::endl;
+
+		std::cout << "Creating vector B with std::move(A) passed to B's move constructor." << std::endl;
+		auto data = a.data();
+		sc::vector<std::string> b(std::move(a));
+		std::cout << ">>> Vector B: " << std::endl;
+		std::cout << b << std::endl;
+		std::cout << ">>> B took A's memory: " << (b.data() == data ? "yes" : "no") << std::endl;
+		std::cout << ">>> Size and capacity of A: " << a.size() << " " << a.capacity() << std::endl << std::endl;
+
+		std::cout << "Pushing back to A again and moving B into it with the move assignment." << std::endl;
+		a.push_back("left behind");
+		a = std::move(b);
+		std::cout << ">>> Vector A: " << std::endl;
+		std::cout << a << std::endl;
+
+		std::cout << "Reserving room for 100 elements in A and shrinking it back." << std::endl;
+		a.reserve(100);
+		std::cout << ">>> Capacity of A after reserve(): " << a.capacity() << std::endl;
+		a.shrink_to_fit();
+		std::cout << ">>> Capacity of A after shrink_to_fit(): " << a.capacity() << std::endl;
+		std::cout << a << std::endl;
+	}
+	std::cout << std::endl;
+	{
+		std::cout << "Testing - Iterators | std::sort() | Insert() and Erase() by position:" << std::endl << std::endl;
+		std::cout << "Pushing back to vector A the numbers 7, 3, 9, 1, 5, 8, 2:" << std::endl;
+		sc::vector<int> a;
+		for(auto x : {7, 3, 9, 1, 5, 8, 2}) a.push_back(x);
+
+		std::cout << ">>> Vector A: " << std::endl;
+		std::cout << a << std::endl;
+
+		std::cout << "Sorting A with std::sort( a.begin(), a.end() )." << std::endl;
+		std::sort(a.begin(), a.end());
+		std::cout << ">>> Vector A: " << std::endl;
+		std::cout << a << std::endl;
+
+		auto it = std::lower_bound(a.begin(), a.end(), 6);
+		std::cout << ">>> First element not less than 6: " << *it << ", at position " << it - a.begin() << std::endl;
+		std::cout << ">>> Element at a.begin()[2]: " << a.begin()[2] << std::endl;
+
+		sc::vector<int>::const_iterator ci = a.cbegin() + 2;
+		std::cout << ">>> a.begin() == a.cbegin(): " << (a.begin() == a.cbegin() ? "true" : "false") << std::endl;
+		std::cout << ">>> a.begin() < a.cbegin() + 2: " << (a.begin() < ci ? "true" : "false") << std::endl;
+		std::cout << ">>> a.end() - (a.cbegin() + 2): " << a.end() - ci << std::endl << std::endl;
+
+		std::cout << "Inserting 6 before it, and erasing the last two elements with a.erase( a.end() - 2, a.end() )." << std::endl;
+		a.insert(it, 6);
+		a.erase(a.end() - 2, a.end());
+		std::cout << ">>> Vector A: " << std::endl;
+		std::cout << a << std::endl;
+
+		std::cout << "Inserting a copy of A's first three elements at its end." << std::endl;
+		a.insert(a.end(), a.begin(), a.begin() + 3);
+		std::cout << ">>> Vector A: " << std::endl;
+		std::cout << a << std::endl;
+
+		std::cout << "Printing A backwards with std::reverse_iterator:" << std::endl;
+		using reverse = std::reverse_iterator< sc::vector<int>::const_iterator >;
+		for(auto r = reverse(a.cend()); r != reverse(a.cbegin()); ++r)
+			std::cout << *r << " ";
+		std::cout << std::endl;
+	}
+	std::cout << std::endl;
+	{
+		std::cout << "Testing - small_vector | Inline storage | Growing past it:" << std::endl << std::endl;
+		sc::small_vector<int, 4> a;
+		std::cout << ">>> Capacity of an empty small_vector<int, 4> A: " << a.capacity() << std::endl << std::endl;
+
+		std::cout << "Pushing back to vector A the numbers 1 to 4, which fit inline:" << std::endl;
+		for(int i = 1; i <= 4; ++i) a.push_back(i);
+		std::cout << ">>> Vector A: " << std::endl;
+		std::cout << a << std::endl;
+		std::cout << ">>> Capacity of A: " << a.capacity() << std::endl << std::endl;
+
+		std::cout << "Pushing back 5 and 6, which move A's elements to the heap:" << std::endl;
+		a.push_back(5);
+		a.push_back(6);
+		std::cout << ">>> Vector A: " << std::endl;
+		std::cout << a << std::endl;
+		std::cout << ">>> Capacity of A: " << a.capacity() << std::endl << std::endl;
+
+		std::cout << "Popping back three elements and calling shrink_to_fit(), which brings them back inline:" << std::endl;
+		for(int i = 0; i < 3; ++i) a.pop_back();
+		a.shrink_to_fit();
+		std::cout << ">>> Vector A: " << std::endl;
+		std::cout << a << std::endl;
+		std::cout << ">>> Capacity of A: " << a.capacity() << std::endl << std::endl;
+
+		std::cout << "Moving A into a new vector B:" << std::endl;
+		sc::small_vector<int, 4> b(std::move(a));
+		std::cout << ">>> Vector B: " << std::endl;
+		std::cout << b << std::endl;
+		std::cout << ">>> Size of A: " << a.size() << ", capacity of A: " << a.capacity() << std::endl;
+	}
 }
\ No newline at end of file